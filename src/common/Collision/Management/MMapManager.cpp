@@ -19,15 +19,43 @@
 #include "Errors.h"
 #include "Log.h"
 #include "MMapDefines.h"
+#include "MappedFile.h"
+#include "Metric.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
 
 namespace MMAP
 {
     constexpr char MAP_FILE_NAME_FORMAT[] = "{}mmaps/{:03}.mmap";
     constexpr char TILE_FILE_NAME_FORMAT[] = "{}mmaps/{:03}{:02}{:02}.mmtile";
 
+    // prefetched tiles that were never loaded are dropped oldest first past this count
+    constexpr std::size_t MAX_PREFETCHED_TILES = 64;
+
+    // ######################## MMapData ########################
+    MMapData::MMapData(dtNavMesh* mesh) : navMesh(mesh), navMeshLock(std::make_shared<NavMeshLock>()) { }
+
+    MMapData::~MMapData()
+    {
+        for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
+            dtFreeNavMeshQuery(i->second);
+
+        // tiles are added without DT_TILE_FREE_DATA, their data is released with loadedTileFiles after this
+        if (navMesh)
+            dtFreeNavMesh(navMesh);
+    }
+
     // ######################## MMapManager ########################
+    MMapManager::MMapManager() : loadedTiles(0), thread_safe_environment(true), prefetchThread(std::make_unique<Trinity::ThreadPool>(1))
+    {
+    }
+
     MMapManager::~MMapManager()
     {
+        prefetchThread.reset();
+
         for (std::pair<uint32 const, MMapData*>& loadedMMap : loadedMMaps)
             delete loadedMMap.second;
 
@@ -127,21 +155,27 @@ namespace MMAP
         if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
             return false;
 
+        auto loadStart = std::chrono::steady_clock::now();
+
         // load this tile :: mmaps/MMMXXYY.mmtile
-        std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, basePath, mapId, x, y);
-        FILE* file = fopen(fileName.c_str(), "rb");
+        std::unique_ptr<Trinity::MappedFile> file = takePrefetchedTile(mapId, packedGridPos);
+        bool prefetched = file != nullptr;
         if (!file)
         {
-            TC_LOG_DEBUG("maps", "MMAP:loadMap: Could not open mmtile file '{}'", fileName);
-            return false;
+            std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, basePath, mapId, x, y);
+            file = Trinity::MappedFile::OpenCopyOnWrite(fileName);
+            if (!file)
+            {
+                TC_LOG_DEBUG("maps", "MMAP:loadMap: Could not open mmtile file '{}'", fileName);
+                return false;
+            }
         }
 
         // read header
         MmapTileHeader fileHeader;
-        if (fread(&fileHeader, sizeof(MmapTileHeader), 1, file) != 1 || fileHeader.mmapMagic != MMAP_MAGIC)
+        if (!file->Read(0, fileHeader) || fileHeader.mmapMagic != MMAP_MAGIC)
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header in mmap {:03}{:02}{:02}.mmtile", mapId, x, y);
-            fclose(file);
             return false;
         }
 
@@ -149,53 +183,122 @@ namespace MMAP
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: {:03}{:02}{:02}.mmtile was built with generator v{}, expected v{}",
                 mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
-            fclose(file);
             return false;
         }
 
-        long pos = ftell(file);
-        fseek(file, 0, SEEK_END);
-        if (pos < 0 || static_cast<int32>(fileHeader.size) > ftell(file) - pos)
+        if (fileHeader.size > file->GetSize() - sizeof(MmapTileHeader))
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: {:03}{:02}{:02}.mmtile has corrupted data size", mapId, x, y);
-            fclose(file);
             return false;
         }
 
-        fseek(file, pos, SEEK_SET);
-
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
-
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
-        {
-            TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap {:03}{:02}{:02}.mmtile", mapId, x, y);
-            fclose(file);
-            return false;
-        }
-
-        fclose(file);
-
+        // detour links the tile by writing into its data, the mapping is copy on write so only those pages stop being shared
+        unsigned char* data = file->GetData() + sizeof(MmapTileHeader);
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        // data stays owned by the mapping, it must not be freed by detour
+        std::unique_lock<std::shared_mutex> navMeshGuard(mmap->navMeshLock->mutex);
+        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, 0, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            mmap->loadedTileFiles[packedGridPos] = std::move(file);
             ++loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:03}[{:02}, {:02}] into {:03}[{:02}, {:02}]", mapId, x, y, mapId, header->x, header->y);
+
+            TC_METRIC_VALUE("mmap_tile_load_time", uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count()),
+                TC_METRIC_TAG("map_id", std::to_string(mapId)),
+                TC_METRIC_TAG("prefetched", prefetched ? "1" : "0"));
             return true;
         }
         else
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Could not load {:03}{:02}{:02}.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
             return false;
         }
     }
 
+    void MMapManager::prefetchMap(std::string const& basePath, uint32 mapId, int32 x, int32 y)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return;
+
+        uint32 packedGridPos = packTileID(x, y);
+        if (itr->second->loadedTileRefs.count(packedGridPos))
+            return;
+
+        uint64 key = uint64(mapId) << 32 | packedGridPos;
+        {
+            std::lock_guard<std::mutex> lock(prefetchLock);
+            if (!prefetchedTiles.try_emplace(key).second)
+                return;
+
+            prefetchOrder.push_back(key);
+            while (prefetchedTiles.size() > MAX_PREFETCHED_TILES)
+            {
+                prefetchedTiles.erase(prefetchOrder.front());
+                prefetchOrder.erase(prefetchOrder.begin());
+            }
+        }
+
+        prefetchThread->PostWork([this, key, fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, basePath, mapId, x, y)]()
+        {
+            std::unique_ptr<Trinity::MappedFile> file = Trinity::MappedFile::OpenCopyOnWrite(fileName);
+            if (file)
+            {
+                // fault every page in now, reading them does not break sharing
+                uint8 const* data = std::as_const(*file).GetData();
+                uint8 volatile sum = 0;
+                for (std::size_t i = 0; i < file->GetSize(); i += 4096)
+                    sum = sum + data[i];
+            }
+
+            std::lock_guard<std::mutex> lock(prefetchLock);
+            auto prefetched = prefetchedTiles.find(key);
+            if (prefetched == prefetchedTiles.end())
+                return;                         // loaded or dropped while this was running
+
+            if (file)
+                prefetched->second = std::move(file);
+            else
+            {
+                // tile does not exist, let loadMap find that out itself
+                prefetchedTiles.erase(prefetched);
+                prefetchOrder.erase(std::find(prefetchOrder.begin(), prefetchOrder.end(), key));
+            }
+        });
+    }
+
+    std::unique_ptr<Trinity::MappedFile> MMapManager::takePrefetchedTile(uint32 mapId, uint32 packedGridPos)
+    {
+        uint64 key = uint64(mapId) << 32 | packedGridPos;
+
+        std::lock_guard<std::mutex> lock(prefetchLock);
+        auto itr = prefetchedTiles.find(key);
+        if (itr == prefetchedTiles.end())
+            return nullptr;
+
+        // a prefetch still in progress is abandoned, mapping the file again is cheaper than waiting for it
+        std::unique_ptr<Trinity::MappedFile> file = std::move(itr->second);
+        prefetchedTiles.erase(itr);
+        prefetchOrder.erase(std::find(prefetchOrder.begin(), prefetchOrder.end(), key));
+        return file;
+    }
+
+    void MMapManager::dropPrefetchedTiles(uint32 mapId)
+    {
+        std::lock_guard<std::mutex> lock(prefetchLock);
+        prefetchOrder.erase(std::remove_if(prefetchOrder.begin(), prefetchOrder.end(), [&](uint64 key)
+        {
+            if (key >> 32 != mapId)
+                return false;
+
+            prefetchedTiles.erase(key);
+            return true;
+        }), prefetchOrder.end());
+    }
+
     bool MMapManager::loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId)
     {
         if (!loadMapData(basePath, mapId))
@@ -247,6 +350,7 @@ namespace MMAP
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
 
         // unload, and mark as non loaded
+        std::unique_lock<std::shared_mutex> navMeshGuard(mmap->navMeshLock->mutex);
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
         {
             // this is technically a memory leak
@@ -258,6 +362,7 @@ namespace MMAP
         else
         {
             mmap->loadedTileRefs.erase(packedGridPos);
+            mmap->loadedTileFiles.erase(packedGridPos);
             --loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:03}[{:02}, {:02}] from {:03}", mapId, x, y, mapId);
             return true;
@@ -278,6 +383,7 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        std::unique_lock<std::shared_mutex> navMeshGuard(mmap->navMeshLock->mutex);
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -291,8 +397,12 @@ namespace MMAP
             }
         }
 
+        // searches running on the navmesh are done once the lock is held, the ones still queued skip it
+        mmap->navMeshLock->unloaded = true;
+        navMeshGuard.unlock();
         delete mmap;
         itr->second = nullptr;
+        dropPrefetchedTiles(mapId);
         TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded {:03}.mmap", mapId);
 
         return true;
@@ -333,6 +443,15 @@ namespace MMAP
         return itr->second->navMesh;
     }
 
+    std::shared_ptr<NavMeshLock> MMapManager::GetNavMeshLock(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        return itr->second->navMeshLock;
+    }
+
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         auto itr = GetMMapData(mapId);
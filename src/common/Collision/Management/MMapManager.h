@@ -21,34 +21,48 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+namespace Trinity
+{
+    class MappedFile;
+    class ThreadPool;
+}
+
 //  move map related classes
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<uint32, std::unique_ptr<Trinity::MappedFile>> MMapTileFileSet;
+
+    // navMesh is shared by all instances of the map, searches on other threads hold mutex shared while tiles are added or removed exclusively
+    // searches keep it alive, so the ones still queued when the map is unloaded find it set unloaded instead of a deleted mutex
+    struct NavMeshLock
+    {
+        std::shared_mutex mutex;
+        bool unloaded = false;              // set under mutex when navMesh is deleted
+    };
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
-        ~MMapData()
-        {
-            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
-
-            if (navMesh)
-                dtFreeNavMesh(navMesh);
-        }
+        MMapData(dtNavMesh* mesh);
+        ~MMapData();
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+        MMapTileFileSet loadedTileFiles;   // maps [map grid coords] to the mapping holding [dtTile] data, must outlive navMesh
+
+        std::shared_ptr<NavMeshLock> navMeshLock;
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
@@ -58,7 +72,7 @@ namespace MMAP
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager();
             ~MMapManager();
 
             void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
@@ -68,20 +82,32 @@ namespace MMAP
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
+            // maps the tile file and faults its pages in on the loader thread, so a later loadMap for it does not wait for disk
+            void prefetchMap(std::string const& basePath, uint32 mapId, int32 x, int32 y);
+
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            std::shared_ptr<NavMeshLock> GetNavMeshLock(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
         private:
             bool loadMapData(std::string const& basePath, uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            std::unique_ptr<Trinity::MappedFile> takePrefetchedTile(uint32 mapId, uint32 packedGridPos);
+            void dropPrefetchedTiles(uint32 mapId);
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
             bool thread_safe_environment;
+
+            // tiles mapped ahead of loadMap, a null mapping means it is still being prefetched
+            std::mutex prefetchLock;
+            std::unordered_map<uint64, std::unique_ptr<Trinity::MappedFile>> prefetchedTiles;
+            std::vector<uint64> prefetchOrder;  // oldest first
+            std::unique_ptr<Trinity::ThreadPool> prefetchThread;    // destroyed first, stops pending prefetches
     };
 }
 
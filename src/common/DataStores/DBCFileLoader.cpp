@@ -26,63 +26,47 @@ DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), s
 
 bool DBCFileLoader::Load(char const* filename, char const* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
+    data = nullptr;
+    stringTable = nullptr;
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
+    // mapped privately, records used in place can still be corrected in memory
+    file = Trinity::MappedFile::OpenCopyOnWrite(filename);
+    if (!file)
         return false;
 
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
+    uint32 header;
+    if (!file->Read(0, header))
         return false;
-    }
 
     EndianConvert(header);
 
     if (header != 0x43424457)                                //'WDBC'
-    {
-        fclose(f);
         return false;
-    }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
+    if (!file->Read(4, recordCount))                         // Number of records
         return false;
-    }
 
     EndianConvert(recordCount);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    if (!file->Read(8, fieldCount))                          // Number of fields
         return false;
-    }
 
     EndianConvert(fieldCount);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
+    if (!file->Read(12, recordSize))                         // Size of a record
         return false;
-    }
 
     EndianConvert(recordSize);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
+    if (!file->Read(16, stringSize))                         // String size
         return false;
-    }
 
     EndianConvert(stringSize);
 
+    if (file->GetSize() - HeaderSize < uint64(recordSize) * recordCount + stringSize)
+        return false;
+
+    delete[] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -94,24 +78,14 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = file->GetData() + HeaderSize;
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
     delete[] fieldsOffset;
 }
 
@@ -121,6 +95,13 @@ DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
     return Record(*this, data + id * recordSize);
 }
 
+std::unique_ptr<Trinity::MappedFile> DBCFileLoader::ReleaseFile()
+{
+    data = nullptr;
+    stringTable = nullptr;
+    return std::move(file);
+}
+
 uint32 DBCFileLoader::GetFormatRecordSize(char const* format, int32* index_pos)
 {
     uint32 recordsize = 0;
@@ -166,6 +147,84 @@ uint32 DBCFileLoader::GetFormatRecordSize(char const* format, int32* index_pos)
     return recordsize;
 }
 
+bool DBCFileLoader::CanUseRecordsInPlace(char const* format) const
+{
+#if TRINITY_ENDIAN == TRINITY_BIGENDIAN
+    (void)format;
+    return false;
+#else
+    if (strlen(format) != fieldCount)
+        return false;
+
+    // the structure has to match the start of the record: no strings (pointers in memory, offsets on disk)
+    // and no skipped or sort-only fields before the last used one
+    // 4 byte fields also have to sit at 4 byte aligned offsets, the compiler pads them there in the structure
+    uint32 usedFields = 0;
+    bool hasWideFields = false;
+    for (; format[usedFields]; ++usedFields)
+    {
+        if (format[usedFields] == FT_BYTE)
+            continue;
+        if (format[usedFields] != FT_IND && format[usedFields] != FT_INT && format[usedFields] != FT_FLOAT)
+            break;
+        if (GetOffset(usedFields) % sizeof(uint32) != 0)
+            return false;
+        hasWideFields = true;
+    }
+
+    if (!usedFields)
+        return false;
+
+    for (uint32 x = usedFields; format[x]; ++x)
+        if (format[x] != FT_NA)
+            return false;
+
+    // the file has to be laid out as the format says, records of structures with 4 byte fields have to stay aligned
+    uint32 layoutSize = GetOffset(fieldCount - 1) + (format[fieldCount - 1] == FT_BYTE ? sizeof(uint8) : sizeof(uint32));
+    return layoutSize == recordSize && (!hasWideFields || recordSize % sizeof(uint32) == 0);
+#endif
+}
+
+bool DBCFileLoader::AutoProduceIndex(char const* format, uint32& records, char**& indexTable)
+{
+    typedef char* ptr;
+    if (!CanUseRecordsInPlace(format))
+        return false;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        //find max index
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)
+                maxi = ind;
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi * sizeof(ptr));
+
+        for (uint32 y = 0; y < recordCount; ++y)
+            indexTable[getRecord(y).getUInt(i)] = reinterpret_cast<char*>(data + y * recordSize);
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+
+        for (uint32 y = 0; y < recordCount; ++y)
+            indexTable[y] = reinterpret_cast<char*>(data + y * recordSize);
+    }
+
+    return true;
+}
+
 char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**& indexTable)
 {
     /*
@@ -258,13 +317,10 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
+bool DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
-        return nullptr;
-
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+        return false;
 
     uint32 offset = 0;
 
@@ -289,10 +345,7 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     // fill only not filled entries
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !**slot)
-                    {
-                        const char * st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
-                    }
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     offset += sizeof(char*);
                     break;
                  }
@@ -310,5 +363,5 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return true;
 }
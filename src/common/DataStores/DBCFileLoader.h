@@ -20,7 +20,9 @@
 
 #include "Define.h"
 #include "Errors.h"
+#include "MappedFile.h"
 #include "Utilities/ByteConverter.h"
+#include <memory>
 
 enum DbcFieldFormat
 {
@@ -94,10 +96,20 @@ class TC_COMMON_API DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != nullptr; }
+        // True when structures described by fmt can point straight at the records in the file
+        bool CanUseRecordsInPlace(char const* fmt) const;
+        // Builds only the index table, pointing at the records in the file. Fails when CanUseRecordsInPlace does
+        bool AutoProduceIndex(char const* fmt, uint32& count, char**& indexTable);
         char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
-        char* AutoProduceStrings(char const* fmt, char* dataTable);
+        // Points the string fields of dataTable at the strings in the file
+        bool AutoProduceStrings(char const* fmt, char* dataTable);
+        // Hands over the mapped file, records and strings given out by this loader stay valid as long as it is alive
+        std::unique_ptr<Trinity::MappedFile> ReleaseFile();
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = nullptr);
     private:
+        static constexpr uint32 HeaderSize = 20;
+
+        std::unique_ptr<Trinity::MappedFile> file;
 
         uint32 recordSize;
         uint32 recordCount;
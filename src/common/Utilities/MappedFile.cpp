@@ -0,0 +1,102 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MappedFile.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <mutex>
+#include <unordered_map>
+
+namespace Trinity
+{
+struct MappedFile::Region
+{
+    boost::interprocess::mapped_region Mapping;
+};
+
+namespace
+{
+    std::mutex OpenFilesLock;
+    std::unordered_map<std::string, std::weak_ptr<MappedFile const>> OpenFiles;
+}
+
+std::unique_ptr<MappedFile::Region> MappedFile::MapRegion(std::string const& fileName, bool copyOnWrite)
+{
+    std::unique_ptr<Region> region = std::make_unique<Region>();
+    try
+    {
+        // the mapping stays valid without the file descriptor, close it right away instead of holding
+        // one descriptor for every mapped tile and DBC file
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        region->Mapping = boost::interprocess::mapped_region(file, copyOnWrite ? boost::interprocess::copy_on_write : boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        // missing, unreadable or empty file (empty files can not be mapped)
+        return nullptr;
+    }
+
+    return region;
+}
+
+std::shared_ptr<MappedFile const> MappedFile::Open(std::string const& fileName)
+{
+    std::lock_guard<std::mutex> lock(OpenFilesLock);
+
+    auto itr = OpenFiles.find(fileName);
+    if (itr != OpenFiles.end())
+        if (std::shared_ptr<MappedFile const> file = itr->second.lock())
+            return file;
+
+    std::unique_ptr<Region> region = MapRegion(fileName, false);
+    if (!region)
+        return nullptr;
+
+    // the registry entry goes away with the last reference, unless the file was opened again in the meantime
+    std::shared_ptr<MappedFile const> file(new MappedFile(std::move(region)), [fileName](MappedFile const* mappedFile)
+    {
+        {
+            std::lock_guard<std::mutex> lock(OpenFilesLock);
+            auto itr = OpenFiles.find(fileName);
+            if (itr != OpenFiles.end() && itr->second.expired())
+                OpenFiles.erase(itr);
+        }
+
+        delete mappedFile;
+    });
+
+    OpenFiles[fileName] = file;
+    return file;
+}
+
+std::unique_ptr<MappedFile> MappedFile::OpenCopyOnWrite(std::string const& fileName)
+{
+    std::unique_ptr<Region> region = MapRegion(fileName, true);
+    if (!region)
+        return nullptr;
+
+    return std::unique_ptr<MappedFile>(new MappedFile(std::move(region)));
+}
+
+MappedFile::MappedFile(std::unique_ptr<Region> region) : _region(std::move(region))
+{
+    _data = static_cast<uint8*>(_region->Mapping.get_address());
+    _size = _region->Mapping.get_size();
+}
+
+MappedFile::~MappedFile() = default;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAPPED_FILE_H
+#define TRINITY_MAPPED_FILE_H
+
+#include "Define.h"
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace Trinity
+{
+/// Read only mapping of a whole file into memory.
+/// Pages are only read from disk when first accessed and stay shared with every other
+/// mapping of the same file, including the ones made by other processes.
+class TC_COMMON_API MappedFile
+{
+public:
+    /// Returns the mapping of fileName, reusing the one already made by this process if it is still alive.
+    /// Returns nullptr when the file can not be opened or is empty.
+    static std::shared_ptr<MappedFile const> Open(std::string const& fileName);
+
+    /// Returns a private mapping of fileName that can be written to, written pages get copied and never reach the file.
+    /// Returns nullptr when the file can not be opened or is empty.
+    static std::unique_ptr<MappedFile> OpenCopyOnWrite(std::string const& fileName);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    uint8 const* GetData() const { return _data; }
+    uint8* GetData() { return _data; }
+    std::size_t GetSize() const { return _size; }
+
+    /// Copies sizeof(T) bytes at offset into value, returns false when they are not all inside the file
+    template<typename T>
+    bool Read(std::size_t offset, T& value) const
+    {
+        if (offset > _size || _size - offset < sizeof(T))
+            return false;
+
+        std::memcpy(&value, _data + offset, sizeof(T));
+        return true;
+    }
+
+    /// Returns a pointer to count objects of type T at offset, nullptr when they are not all inside the file
+    /// or when offset is not suitably aligned for T
+    template<typename T>
+    T const* GetArray(std::size_t offset, std::size_t count) const
+    {
+        if (offset > _size || (_size - offset) / sizeof(T) < count)
+            return nullptr;
+
+        if ((reinterpret_cast<uintptr_t>(_data) + offset) % alignof(T) != 0)
+            return nullptr;
+
+        return reinterpret_cast<T const*>(_data + offset);
+    }
+
+private:
+    struct Region;
+
+    static std::unique_ptr<Region> MapRegion(std::string const& fileName, bool copyOnWrite);
+
+    MappedFile(std::unique_ptr<Region> region);
+
+    std::unique_ptr<Region> _region;
+    uint8* _data;
+    std::size_t _size;
+};
+}
+
+#endif // TRINITY_MAPPED_FILE_H
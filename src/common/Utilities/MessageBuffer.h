@@ -37,6 +37,11 @@ public:
         _storage.resize(initialSize);
     }
 
+    // Takes ownership of already written data, nothing is copied
+    explicit MessageBuffer(std::vector<uint8>&& storage) : _wpos(storage.size()), _rpos(0), _storage(std::move(storage))
+    {
+    }
+
     MessageBuffer(MessageBuffer const& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right._storage)
     {
     }
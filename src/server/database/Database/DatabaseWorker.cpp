@@ -16,8 +16,12 @@
  */
 
 #include "DatabaseWorker.h"
+#include "Log.h"
+#include "Metric.h"
+#include "MySQLConnection.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
+#include <mysqld_error.h>
 
 DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
 {
@@ -41,6 +45,8 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    _batch.reserve(MAX_BATCHED_OPERATIONS);
+
     for (;;)
     {
         SQLOperation* operation = nullptr;
@@ -50,9 +56,114 @@ void DatabaseWorker::WorkerThread()
         if (_cancelationToken || !operation)
             return;
 
+        // Take consecutive operations without results off the queue so they share one transaction
+        // and one commit, the first operation that can't be batched ends the batch and runs after it
+        while (operation && operation->IsBatchable())
+        {
+            operation->SetConnection(_connection);
+            _batch.push_back(operation);
+            operation = nullptr;
+
+            if (_batch.size() >= MAX_BATCHED_OPERATIONS || !_queue->Pop(operation))
+                break;
+        }
+
+        if (!_batch.empty())
+            ExecuteBatch();
+
+        if (!operation)
+            continue;
+
         operation->SetConnection(_connection);
         operation->call();
 
         delete operation;
     }
 }
+
+void DatabaseWorker::ExecuteBatch()
+{
+    // single operations are not reported, one value per statement would flood the metrics
+    if (_batch.size() == 1)
+    {
+        ExecuteBatchSeparately();
+        return;
+    }
+
+    TC_METRIC_VALUE("db_batch_size", uint64(_batch.size()), TC_METRIC_TAG("db", _connection->GetDatabaseName()));
+    TC_METRIC_TIMER("db_batch_time", TC_METRIC_TAG("db", _connection->GetDatabaseName()));
+
+    _connection->BeginTransaction();
+
+    // A statement losing the connection must not be executed again on the new one, the open transaction
+    // and everything executed in it so far went away with the old connection
+    uint32 reconnectCount = _connection->GetReconnectCount();
+    _connection->SetRetryAfterReconnect(false);
+
+    for (std::size_t i = 0; i < _batch.size(); ++i)
+    {
+        if (_batch[i]->ExecuteInBatch())
+            continue;
+
+        _connection->SetRetryAfterReconnect(true);
+
+        if (_connection->GetReconnectCount() != reconnectCount)
+        {
+            // Nothing of the batch reached the database, execute all of it again in the original order
+            TC_LOG_WARN("sql.sql", "Connection lost during a batch of {} operations, executing them one by one.", uint32(_batch.size()));
+            ExecuteBatchSeparately();
+            return;
+        }
+
+        uint32 errorCode = _connection->GetLastError();
+
+        // Errors were already logged by the failing operation, discard the work done so far and execute
+        // the operations before it again on their own so only the failing one is lost
+        TC_LOG_WARN("sql.sql", "Operation {} of a batch of {} failed, executing the others one by one.", uint32(i + 1), uint32(_batch.size()));
+        _connection->RollbackTransaction();
+
+        // Deadlocks are caused by the locks held by the batch, the operation gets another chance on its own.
+        // Any other error would only be repeated and logged again
+        if (errorCode != ER_LOCK_DEADLOCK)
+        {
+            delete _batch[i];
+            _batch[i] = nullptr;
+        }
+
+        ExecuteBatchSeparately();
+        return;
+    }
+
+    // COMMIT is not sent again after a reconnect either, the new connection has no open transaction to commit
+    bool committed = _connection->CommitTransaction();
+    _connection->SetRetryAfterReconnect(true);
+
+    if (!committed)
+    {
+        if (_connection->GetReconnectCount() == reconnectCount)
+            _connection->RollbackTransaction();
+
+        TC_LOG_WARN("sql.sql", "Commit of a batch of {} operations failed, executing them one by one.", uint32(_batch.size()));
+        ExecuteBatchSeparately();
+        return;
+    }
+
+    for (SQLOperation* operation : _batch)
+        delete operation;
+
+    _batch.clear();
+}
+
+void DatabaseWorker::ExecuteBatchSeparately()
+{
+    for (SQLOperation* operation : _batch)
+    {
+        if (!operation)
+            continue;
+
+        operation->call();
+        delete operation;
+    }
+
+    _batch.clear();
+}
@@ -21,6 +21,9 @@
 #include "Define.h"
 #include <atomic>
 #include <thread>
+#include <vector>
+
+#define MAX_BATCHED_OPERATIONS 32
 
 template <typename T>
 class ProducerConsumerQueue;
@@ -39,8 +42,12 @@ class TC_DATABASE_API DatabaseWorker
         MySQLConnection* _connection;
 
         void WorkerThread();
+        void ExecuteBatch();
+        void ExecuteBatchSeparately();
         std::thread _workerThread;
 
+        std::vector<SQLOperation*> _batch;
+
         std::atomic<bool> _cancelationToken;
 
         DatabaseWorker(DatabaseWorker const& right) = delete;
@@ -18,6 +18,7 @@
 #include "MySQLConnection.h"
 #include "Common.h"
 #include "DatabaseWorker.h"
+#include "Field.h"
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLPreparedStatement.h"
@@ -29,6 +30,162 @@
 #include <errmsg.h>
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#define MAX_COALESCED_ROWS 64
+#define MAX_COALESCED_STATEMENT_PARAMS 65535
+
+//- Multi-row form of a prepared INSERT/REPLACE ... VALUES (...) or DELETE ... WHERE a = ? AND b = ?
+//- Runs of the same statement inside a transaction are sent as one statement with a power of two rows,
+//- each row count is prepared on first use
+class MySQLCoalescedStatement
+{
+public:
+    MySQLCoalescedStatement(std::string prefix, std::string row, std::string suffix, uint32 paramCount) :
+        Prefix(std::move(prefix)), Row(std::move(row)), Suffix(std::move(suffix)), ParamCount(paramCount) { }
+
+    std::string BuildQuery(std::size_t rows) const
+    {
+        std::string query;
+        query.reserve(Prefix.length() + (Row.length() + 2) * rows + Suffix.length());
+        query += Prefix;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            if (i)
+                query += ", ";
+            query += Row;
+        }
+        query += Suffix;
+        return query;
+    }
+
+    std::string Prefix;
+    std::string Row;
+    std::string Suffix;
+    uint32 ParamCount;
+    std::array<std::unique_ptr<MySQLPreparedStatement>, std::countr_zero(uint32(MAX_COALESCED_ROWS))> Statements; // 2 << i rows
+};
+
+namespace
+{
+    bool IsIdentifierChar(char c)
+    {
+        return isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '`' || c == '.';
+    }
+
+    //- "INSERT INTO t (a, b) VALUES (?, ?)" -> "INSERT INTO t (a, b) VALUES " + "(?, ?)"
+    //- the row has to end the query, so ON DUPLICATE KEY UPDATE clauses are left alone
+    std::unique_ptr<MySQLCoalescedStatement> ParseCoalescedInsert(std::string_view sql, uint32 paramCount)
+    {
+        std::size_t values = sql.find("VALUES");
+        if (values == std::string_view::npos)
+            return nullptr;
+
+        std::size_t open = sql.find('(', values);
+        if (open == std::string_view::npos)
+            return nullptr;
+
+        std::size_t close = std::string_view::npos;
+        int32 depth = 0;
+        for (std::size_t i = open; i < sql.length() && close == std::string_view::npos; ++i)
+        {
+            switch (sql[i])
+            {
+                case '(':
+                    ++depth;
+                    break;
+                case ')':
+                    if (!--depth)
+                        close = i;
+                    break;
+                case '\'':
+                case '"':
+                    return nullptr;
+                default:
+                    break;
+            }
+        }
+
+        if (close == std::string_view::npos || sql.find_first_not_of(" ;", close + 1) != std::string_view::npos)
+            return nullptr;
+
+        return std::make_unique<MySQLCoalescedStatement>(std::string(sql.substr(0, open)), std::string(sql.substr(open, close - open + 1)), "", paramCount);
+    }
+
+    //- "DELETE FROM t WHERE a = ? AND b = ?" -> "DELETE FROM t WHERE (a, b) IN (" + "(?, ?)" + ")"
+    std::unique_ptr<MySQLCoalescedStatement> ParseCoalescedDelete(std::string_view sql, uint32 paramCount)
+    {
+        std::size_t where = sql.find(" WHERE ");
+        if (where == std::string_view::npos)
+            return nullptr;
+
+        std::vector<std::string_view> tokens = Trinity::Tokenize(sql.substr(where + 7), ' ', false);
+        if (tokens.size() % 4 != 3 || tokens.size() / 4 + 1 != paramCount)
+            return nullptr;
+
+        std::string columns;
+        for (std::size_t i = 0; i < tokens.size(); i += 4)
+        {
+            if (tokens[i + 1] != "=" || tokens[i + 2] != "?" || (i + 3 < tokens.size() && tokens[i + 3] != "AND"))
+                return nullptr;
+
+            if (std::find_if_not(tokens[i].begin(), tokens[i].end(), IsIdentifierChar) != tokens[i].end())
+                return nullptr;
+
+            if (i)
+                columns += ", ";
+            columns += tokens[i];
+        }
+
+        std::string prefix(sql.substr(0, where + 7));
+        std::string row;
+        if (paramCount == 1)
+        {
+            prefix += columns;
+            row = "?";
+        }
+        else
+        {
+            prefix += "(" + columns + ")";
+            row = "(?";
+            for (uint32 i = 1; i < paramCount; ++i)
+                row += ", ?";
+            row += ")";
+        }
+
+        prefix += " IN (";
+        return std::make_unique<MySQLCoalescedStatement>(std::move(prefix), std::move(row), ")", paramCount);
+    }
+
+    std::unique_ptr<MySQLCoalescedStatement> ParseCoalescedStatement(std::string_view sql, uint32 paramCount)
+    {
+        if (!paramCount)
+            return nullptr;
+
+        if (StringStartsWithI(sql, "INSERT ") || StringStartsWithI(sql, "REPLACE "))
+            return ParseCoalescedInsert(sql, paramCount);
+
+        if (StringStartsWithI(sql, "DELETE FROM "))
+            return ParseCoalescedDelete(sql, paramCount);
+
+        return nullptr;
+    }
+
+    //- Rough size of a parameter in the COM_STMT_EXECUTE packet
+    std::size_t GetParameterPacketSize(PreparedStatementData const& data)
+    {
+        return std::visit([](auto const& value) -> std::size_t
+        {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8>>)
+                return value.size() + 11;
+            else
+                return 16;
+        }, data.data);
+    }
+}
 
 MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 {
@@ -50,18 +207,24 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
+m_retryAfterReconnect(true),
 m_queue(nullptr),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_SYNCH) { }
+m_connectionFlags(CONNECTION_SYNCH),
+m_maxAllowedPacket(1024 * 1024) { }
 
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
+m_retryAfterReconnect(true),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_ASYNC)
+m_connectionFlags(CONNECTION_ASYNC),
+m_maxAllowedPacket(1024 * 1024)
 {
     m_worker = std::make_unique<DatabaseWorker>(m_queue, this);
 }
@@ -76,6 +239,7 @@ void MySQLConnection::Close()
     // Stop the worker thread before the statements are cleared
     m_worker.reset();
 
+    m_coalescedStmts.clear();
     m_stmts.clear();
 
     if (m_Mysql)
@@ -160,6 +324,13 @@ uint32 MySQLConnection::Open()
         // set connection properties to UTF8 to properly handle locales for different
         // server configs - core sends data in UTF8, so MySQL must expect UTF8 too
         mysql_set_character_set(m_Mysql, "utf8mb4");
+
+        if (ResultSet* result = Query("SELECT @@max_allowed_packet"))
+        {
+            m_maxAllowedPacket = result->Fetch()[0].GetUInt64();
+            delete result;
+        }
+
         return 0;
     }
     else
@@ -173,6 +344,9 @@ uint32 MySQLConnection::Open()
 
 bool MySQLConnection::PrepareStatements()
 {
+    // multi-row forms are prepared again on demand
+    m_coalescedStmts.clear();
+
     DoPrepareStatements();
     return !m_prepareError;
 }
@@ -192,7 +366,7 @@ bool MySQLConnection::Execute(char const* sql)
             TC_LOG_INFO("sql.sql", "SQL: {}", sql);
             TC_LOG_ERROR("sql.sql", "[{}] {}", lErrno, mysql_error(m_Mysql));
 
-            if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            if (_HandleMySQLErrno(lErrno) && m_retryAfterReconnect)  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return Execute(sql);       // Try again
 
             return false;
@@ -226,10 +400,13 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
         uint32 lErrno = mysql_errno(m_Mysql);
         TC_LOG_ERROR("sql.sql", "SQL(p): {}\n [ERROR]: [{}] {}", m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
 
-        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+        uint32 reconnectCount = m_reconnectCount;
+        if (_HandleMySQLErrno(lErrno) && m_retryAfterReconnect)  // If it returns true, an error was handled successfully (i.e. reconnection)
             return Execute(stmt);       // Try again
 
-        m_mStmt->ClearParameters();
+        // reconnecting prepared all statements again, m_mStmt is gone
+        if (m_reconnectCount == reconnectCount)
+            m_mStmt->ClearParameters();
         return false;
     }
 
@@ -238,10 +415,13 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
         uint32 lErrno = mysql_errno(m_Mysql);
         TC_LOG_ERROR("sql.sql", "SQL(p): {}\n [ERROR]: [{}] {}", m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
 
-        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+        uint32 reconnectCount = m_reconnectCount;
+        if (_HandleMySQLErrno(lErrno) && m_retryAfterReconnect)  // If it returns true, an error was handled successfully (i.e. reconnection)
             return Execute(stmt);       // Try again
 
-        m_mStmt->ClearParameters();
+        // reconnecting prepared all statements again, m_mStmt is gone
+        if (m_reconnectCount == reconnectCount)
+            m_mStmt->ClearParameters();
         return false;
     }
 
@@ -372,35 +552,60 @@ void MySQLConnection::RollbackTransaction()
     Execute("ROLLBACK");
 }
 
-void MySQLConnection::CommitTransaction()
+bool MySQLConnection::CommitTransaction()
 {
-    Execute("COMMIT");
+    return Execute("COMMIT");
 }
 
 int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transaction)
 {
-    std::vector<SQLElementData> const& queries = transaction->m_queries;
-    if (queries.empty())
+    if (transaction->m_queries.empty())
         return -1;
 
     BeginTransaction();
 
-    for (auto itr = queries.begin(); itr != queries.end(); ++itr)
+    if (int errorCode = ExecuteTransactionQueries(transaction))
+    {
+        RollbackTransaction();
+        return errorCode;
+    }
+
+    // we might encounter errors during certain queries, and depending on the kind of error
+    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
+    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
+    // and not while iterating over every element.
+
+    CommitTransaction();
+    return 0;
+}
+
+//- Executes the queries of a transaction without opening or closing it, returns the error code of the first failed query
+//- Consecutive executions of the same INSERT/REPLACE/DELETE statement are merged into multi-row statements
+int MySQLConnection::ExecuteTransactionQueries(std::shared_ptr<TransactionBase> const& transaction)
+{
+    std::vector<SQLElementData> const& queries = transaction->m_queries;
+    for (std::size_t i = 0; i < queries.size();)
     {
-        SQLElementData const& data = *itr;
-        switch (itr->type)
+        SQLElementData const& data = queries[i];
+        switch (data.type)
         {
             case SQL_ELEMENT_PREPARED:
             {
                 PreparedStatementBase* stmt = data.element.stmt;
                 ASSERT(stmt);
-                if (!Execute(stmt))
+
+                std::size_t count = 1;
+                MySQLCoalescedStatement* coalesced = GetCoalescedStatement(stmt->GetIndex());
+                if (coalesced)
+                    count = GetCoalescableRowCount(coalesced, queries, i);
+
+                if (count > 1 ? !ExecuteCoalesced(coalesced, queries, i, count) : !Execute(stmt))
                 {
                     TC_LOG_WARN("sql.sql", "Transaction aborted. {} queries not executed.", (uint32)queries.size());
-                    int errorCode = GetLastError();
-                    RollbackTransaction();
-                    return errorCode;
+                    return GetLastError();
                 }
+
+                i += count;
             }
             break;
             case SQL_ELEMENT_RAW:
@@ -410,24 +615,123 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
                 if (!Execute(sql))
                 {
                     TC_LOG_WARN("sql.sql", "Transaction aborted. {} queries not executed.", (uint32)queries.size());
-                    int errorCode = GetLastError();
-                    RollbackTransaction();
-                    return errorCode;
+                    return GetLastError();
                 }
+
+                ++i;
             }
             break;
         }
     }
 
-    // we might encounter errors during certain queries, and depending on the kind of error
-    // we might want to restart the transaction. So to prevent data loss, we only clean up when it's all done.
-    // This is done in calling functions DatabaseWorkerPool<T>::DirectCommitTransaction and TransactionTask::Execute,
-    // and not while iterating over every element.
-
-    CommitTransaction();
     return 0;
 }
 
+MySQLCoalescedStatement* MySQLConnection::GetCoalescedStatement(uint32 index)
+{
+    auto itr = m_coalescedStmts.find(index);
+    if (itr != m_coalescedStmts.end())
+        return itr->second.get();
+
+    std::unique_ptr<MySQLCoalescedStatement> coalesced;
+    if (index < m_stmts.size() && m_stmts[index])
+        coalesced = ParseCoalescedStatement(m_stmts[index]->m_queryString, m_stmts[index]->GetParameterCount());
+
+    return m_coalescedStmts.emplace(index, std::move(coalesced)).first->second.get();
+}
+
+std::size_t MySQLConnection::GetCoalescableRowCount(MySQLCoalescedStatement const* coalesced, std::vector<SQLElementData> const& queries, std::size_t first) const
+{
+    uint32 index = queries[first].element.stmt->GetIndex();
+    std::size_t maxRows = std::min<std::size_t>(MAX_COALESCED_ROWS, MAX_COALESCED_STATEMENT_PARAMS / coalesced->ParamCount);
+
+    // keep well below max_allowed_packet, the estimate ignores protocol overhead
+    uint64 packetSize = 0;
+    std::size_t rows = 0;
+    for (std::size_t i = first; i < queries.size() && rows < maxRows; ++i)
+    {
+        SQLElementData const& data = queries[i];
+        if (data.type != SQL_ELEMENT_PREPARED || data.element.stmt->GetIndex() != index)
+            break;
+
+        for (PreparedStatementData const& param : data.element.stmt->GetParameters())
+            packetSize += GetParameterPacketSize(param);
+
+        if (rows && packetSize > m_maxAllowedPacket / 2)
+            break;
+
+        ++rows;
+    }
+
+    return rows ? std::bit_floor(rows) : 1;
+}
+
+bool MySQLConnection::ExecuteCoalesced(MySQLCoalescedStatement* coalesced, std::vector<SQLElementData> const& queries, std::size_t first, std::size_t count)
+{
+    if (!m_Mysql)
+        return false;
+
+    std::unique_ptr<MySQLPreparedStatement>& coalescedStmt = coalesced->Statements[std::countr_zero(count) - 1];
+    if (!coalescedStmt)
+    {
+        std::string sql = coalesced->BuildQuery(count);
+        MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
+        if (!stmt || mysql_stmt_prepare(stmt, sql.c_str(), static_cast<unsigned long>(sql.size())))
+        {
+            TC_LOG_ERROR("sql.sql", "In mysql_stmt_prepare() id: {}, sql: \"{}\"", queries[first].element.stmt->GetIndex(), sql);
+            TC_LOG_ERROR("sql.sql", "{}", stmt ? mysql_stmt_error(stmt) : mysql_error(m_Mysql));
+            if (stmt)
+                mysql_stmt_close(stmt);
+
+            // don't try to coalesce this statement again
+            m_coalescedStmts[queries[first].element.stmt->GetIndex()].reset();
+
+            for (std::size_t i = first; i < first + count; ++i)
+                if (!Execute(queries[i].element.stmt))
+                    return false;
+
+            return true;
+        }
+
+        coalescedStmt = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(stmt), std::move(sql));
+    }
+
+    MySQLPreparedStatement* m_mStmt = coalescedStmt.get();
+    for (std::size_t row = 0; row < count; ++row)
+        m_mStmt->BindRowParameters(queries[first + row].element.stmt, uint32(row * coalesced->ParamCount));
+
+    MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
+    MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
+
+    uint32 _s = getMSTime();
+
+    if (mysql_stmt_bind_param(msql_STMT, msql_BIND) || mysql_stmt_execute(msql_STMT))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        TC_LOG_ERROR("sql.sql", "SQL(p): {}\n [ERROR]: [{}] {}", m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
+
+        // reconnecting prepares all statements again and drops the coalesced ones, execute the rows separately
+        uint32 reconnectCount = m_reconnectCount;
+        if (_HandleMySQLErrno(lErrno) && m_retryAfterReconnect)
+        {
+            for (std::size_t i = first; i < first + count; ++i)
+                if (!Execute(queries[i].element.stmt))
+                    return false;
+
+            return true;
+        }
+
+        if (m_reconnectCount == reconnectCount)
+            m_mStmt->ClearParameters();
+        return false;
+    }
+
+    TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {} ({} rows)", getMSTimeDiff(_s, getMSTime()), m_mStmt->m_queryString, count);
+
+    m_mStmt->ClearParameters();
+    return true;
+}
+
 size_t MySQLConnection::EscapeString(char* to, const char* from, size_t length)
 {
     return mysql_real_escape_string(m_Mysql, to, from, length);
@@ -558,6 +862,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
                         (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnectCount;
                 return true;
             }
 
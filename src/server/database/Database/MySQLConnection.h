@@ -24,14 +24,17 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
 
 class DatabaseWorker;
+class MySQLCoalescedStatement;
 class MySQLPreparedStatement;
 class SQLOperation;
+struct SQLElementData;
 
 enum ConnectionFlags
 {
@@ -76,13 +79,21 @@ class TC_DATABASE_API MySQLConnection
 
         void BeginTransaction();
         void RollbackTransaction();
-        void CommitTransaction();
+        bool CommitTransaction();
         int ExecuteTransaction(std::shared_ptr<TransactionBase> transaction);
+        int ExecuteTransactionQueries(std::shared_ptr<TransactionBase> const& transaction);
         size_t EscapeString(char* to, const char* from, size_t length);
         void Ping();
 
         uint32 GetLastError();
 
+        std::string const& GetDatabaseName() const { return m_connectionInfo.database; }
+        /// Number of successful reconnects, anything executed in an open transaction before a reconnect is lost
+        uint32 GetReconnectCount() const { return m_reconnectCount; }
+        /// Whether a statement that lost the connection is executed again after reconnecting, retrying inside
+        /// an open transaction would run it on its own while everything before it is lost
+        void SetRetryAfterReconnect(bool retry) { m_retryAfterReconnect = retry; }
+
     protected:
         /// Tries to acquire lock. If lock is acquired by another thread
         /// the calling parent will just try another connection
@@ -102,16 +113,24 @@ class TC_DATABASE_API MySQLConnection
         PreparedStatementContainer           m_stmts;         //! PreparedStatements storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        uint32                               m_reconnectCount; //! Successful reconnects since the connection was opened
+        bool                                 m_retryAfterReconnect; //! Execute statements again after reconnecting?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
 
+        MySQLCoalescedStatement* GetCoalescedStatement(uint32 index);
+        std::size_t GetCoalescableRowCount(MySQLCoalescedStatement const* coalesced, std::vector<SQLElementData> const& queries, std::size_t first) const;
+        bool ExecuteCoalesced(MySQLCoalescedStatement* coalesced, std::vector<SQLElementData> const& queries, std::size_t first, std::size_t count);
+
         ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
         std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
         MySQLHandle*          m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
         ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
         std::mutex            m_Mutex;
+        uint64                m_maxAllowedPacket;           //! Server side max_allowed_packet, bounds coalesced statements
+        std::unordered_map<uint32, std::unique_ptr<MySQLCoalescedStatement>> m_coalescedStmts; //! Multi-row forms of prepared statements, null if the statement can't be coalesced
 
         MySQLConnection(MySQLConnection const& right) = delete;
         MySQLConnection& operator=(MySQLConnection const& right) = delete;
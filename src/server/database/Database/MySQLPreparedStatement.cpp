@@ -67,7 +67,19 @@ void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 {
     m_stmt = stmt;     // Cross reference them for debug output
 
-    uint8 pos = 0;
+    BindRowParameters(stmt, 0);
+#ifdef _DEBUG
+    if (stmt->GetParameters().size() < m_paramCount)
+        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement {} did not bind all allocated parameters", stmt->GetIndex());
+#endif
+}
+
+void MySQLPreparedStatement::BindRowParameters(PreparedStatementBase* stmt, uint32 offset)
+{
+    if (!offset)
+        m_stmt = stmt;  // first row is used for debug output
+
+    uint32 pos = offset;
     for (PreparedStatementData const& data : stmt->GetParameters())
     {
         std::visit([&](auto&& param)
@@ -76,10 +88,6 @@ void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
         }, data.data);
         ++pos;
     }
-#ifdef _DEBUG
-    if (pos < m_paramCount)
-        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement {} did not bind all allocated parameters", stmt->GetIndex());
-#endif
 }
 
 void MySQLPreparedStatement::ClearParameters()
@@ -94,14 +102,14 @@ void MySQLPreparedStatement::ClearParameters()
     }
 }
 
-static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 paramCount)
+static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint32 index, uint32 paramCount)
 {
-    TC_LOG_ERROR("sql.driver", "Attempted to bind parameter {}{} on a PreparedStatement {} (statement has only {} parameters)", uint32(index) + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
+    TC_LOG_ERROR("sql.driver", "Attempted to bind parameter {}{} on a PreparedStatement {} (statement has only {} parameters)", index + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
     return false;
 }
 
 //- Bind on mysql level
-void MySQLPreparedStatement::AssertValidIndex(uint8 index)
+void MySQLPreparedStatement::AssertValidIndex(uint32 index)
 {
     ASSERT(index < m_paramCount || ParamenterIndexAssertFail(m_stmt->GetIndex(), index, m_paramCount));
 
@@ -109,7 +117,7 @@ void MySQLPreparedStatement::AssertValidIndex(uint8 index)
         TC_LOG_ERROR("sql.sql", "[ERROR] Prepared Statement (id: {}) trying to bind value on already bound index ({}).", m_stmt->GetIndex(), index);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::nullptr_t)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -123,13 +131,13 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
     param->length = nullptr;
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, bool value)
+void MySQLPreparedStatement::SetParameter(uint32 index, bool value)
 {
     SetParameter(index, uint8(value ? 1 : 0));
 }
 
 template<typename T>
-void MySQLPreparedStatement::SetParameter(uint8 index, T value)
+void MySQLPreparedStatement::SetParameter(uint32 index, T value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -146,7 +154,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, T value)
     memcpy(param->buffer, &value, len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, SystemTimePoint value)
+void MySQLPreparedStatement::SetParameter(uint32 index, SystemTimePoint value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -173,7 +181,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, SystemTimePoint value)
     time->second_part = hms.subseconds().count();
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::string const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -190,7 +198,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
     memcpy(param->buffer, value.c_str(), len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::vector<uint8> const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -41,23 +41,25 @@ class TC_DATABASE_API MySQLPreparedStatement
         ~MySQLPreparedStatement();
 
         void BindParameters(PreparedStatementBase* stmt);
+        //- Binds the parameters of stmt starting at parameter index offset, used by statements carrying several rows
+        void BindRowParameters(PreparedStatementBase* stmt, uint32 offset);
 
         uint32 GetParameterCount() const { return m_paramCount; }
 
     protected:
-        void SetParameter(uint8 index, std::nullptr_t);
-        void SetParameter(uint8 index, bool value);
+        void SetParameter(uint32 index, std::nullptr_t);
+        void SetParameter(uint32 index, bool value);
         template<typename T>
-        void SetParameter(uint8 index, T value);
-        void SetParameter(uint8 index, SystemTimePoint value);
-        void SetParameter(uint8 index, std::string const& value);
-        void SetParameter(uint8 index, std::vector<uint8> const& value);
+        void SetParameter(uint32 index, T value);
+        void SetParameter(uint32 index, SystemTimePoint value);
+        void SetParameter(uint32 index, std::string const& value);
+        void SetParameter(uint32 index, std::vector<uint8> const& value);
 
         MySQLStmt* GetSTMT() { return m_Mstmt; }
         MySQLBind* GetBind() { return m_bind; }
         PreparedStatementBase* m_stmt;
         void ClearParameters();
-        void AssertValidIndex(uint8 index);
+        void AssertValidIndex(uint32 index);
         std::string getQueryString() const;
 
     private:
@@ -56,6 +56,12 @@ class TC_DATABASE_API SQLOperation
             return 0;
         }
         virtual bool Execute() = 0;
+
+        //- Whether the operation produces no result and may share a transaction with its neighbours in the queue
+        virtual bool IsBatchable() const { return false; }
+        //- Executes the operation inside a transaction already opened by the worker, returns false if that transaction has to be discarded
+        virtual bool ExecuteInBatch() { return Execute(); }
+
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
         MySQLConnection* m_conn;
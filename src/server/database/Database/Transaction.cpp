@@ -105,6 +105,18 @@ bool TransactionTask::Execute()
     return false;
 }
 
+bool TransactionTask::IsBatchable() const
+{
+    // large transactions gain nothing from sharing a commit and make the whole batch fall back on failure
+    return m_trans->GetSize() && m_trans->GetSize() <= MAX_BATCHED_TRANSACTION_SIZE;
+}
+
+bool TransactionTask::ExecuteInBatch()
+{
+    // errors are not retried here, the worker executes the whole batch again one operation at a time
+    return !m_conn->ExecuteTransactionQueries(m_trans);
+}
+
 int TransactionTask::TryExecute()
 {
     return m_conn->ExecuteTransaction(m_trans);
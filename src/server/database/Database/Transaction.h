@@ -26,6 +26,8 @@
 #include <mutex>
 #include <vector>
 
+#define MAX_BATCHED_TRANSACTION_SIZE 16
+
 /*! Transactions, high level class. */
 class TC_DATABASE_API TransactionBase
 {
@@ -79,8 +81,11 @@ class TC_DATABASE_API TransactionTask : public SQLOperation
         TransactionTask(std::shared_ptr<TransactionBase> trans) : m_trans(trans) { }
         ~TransactionTask() { }
 
+        bool IsBatchable() const override;
+
     protected:
         bool Execute() override;
+        bool ExecuteInBatch() override;
         int TryExecute();
         void CleanupOnFailure();
 
@@ -95,6 +100,8 @@ public:
 
     TransactionFuture GetFuture() { return m_result.get_future(); }
 
+    bool IsBatchable() const override { return false; }
+
 protected:
     bool Execute() override;
 
@@ -31,6 +31,7 @@
 #include "Language.h"
 #include "Log.h"
 #include "Map.h"
+#include "Metric.h"
 #include "MotionMaster.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -155,6 +156,7 @@ uint32 SmartScript::GetCounterValue(uint32 id) const
 
 GameObject* SmartScript::FindGameObjectNear(WorldObject* searchObject, ObjectGuid::LowType guid) const
 {
+    std::shared_lock<std::shared_mutex> storeLock = searchObject->GetMap()->LockObjectsStoreShared();
     auto bounds = searchObject->GetMap()->GetGameObjectBySpawnIdStore().equal_range(guid);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -164,6 +166,7 @@ GameObject* SmartScript::FindGameObjectNear(WorldObject* searchObject, ObjectGui
 
 Creature* SmartScript::FindCreatureNear(WorldObject* searchObject, ObjectGuid::LowType guid) const
 {
+    std::shared_lock<std::shared_mutex> storeLock = searchObject->GetMap()->LockObjectsStoreShared();
     auto bounds = searchObject->GetMap()->GetCreatureBySpawnIdStore().equal_range(guid);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -238,15 +241,21 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
     }
     else
     {
-        for (SmartScriptHolder& event : mEvents)
+        auto itr = std::lower_bound(mEventIndex.begin(), mEventIndex.end(), std::make_pair(uint32(e), uint32(0)));
+        if (itr != mEventIndex.end() && itr->first == uint32(e))
         {
-            SMART_EVENT eventType = SMART_EVENT(event.GetEventType());
-            if (eventType == SMART_EVENT_LINK)//special handling
-                continue;
+            // the tags are evaluated when the timer ends, itr has moved past the events by then
+            [[maybe_unused]] int32 entryOrGuid = mEvents[itr->second].entryOrGuid;
+            TC_METRIC_DETAILED_TIMER("smartscript_process_events_time",
+                TC_METRIC_TAG("entry_or_guid", std::to_string(entryOrGuid)),
+                TC_METRIC_TAG("event", std::to_string(e)));
 
-            if (eventType == e)
+            for (; itr != mEventIndex.end() && itr->first == uint32(e); ++itr)
+            {
+                SmartScriptHolder& event = mEvents[itr->second];
                 if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
                     ProcessEvent(event, unit, var0, var1, bvar, spell, gob);
+            }
         }
     }
 
@@ -3441,6 +3450,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(installevent);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventIndex();
     }
 }
 
@@ -3536,6 +3546,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     if (mEventSortingRequired)
     {
         SortEvents(mEvents);
+        BuildEventIndex();
         mEventSortingRequired = false;
     }
 
@@ -3598,6 +3609,18 @@ void SmartScript::SortEvents(SmartAIEventList& events)
     std::sort(events.begin(), events.end());
 }
 
+void SmartScript::BuildEventIndex()
+{
+    mEventIndex.clear();
+    mEventIndex.reserve(mEvents.size());
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+        if (mEvents[i].GetEventType() != SMART_EVENT_LINK) // special handling, only processed through their source event
+            mEventIndex.emplace_back(mEvents[i].GetEventType(), i);
+
+    // sorting by (type, index) keeps events of the same type in mEvents order
+    std::sort(mEventIndex.begin(), mEventIndex.end());
+}
+
 void SmartScript::RaisePriority(SmartScriptHolder& e)
 {
     e.timer = 1;
@@ -3648,6 +3671,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         mAllEventFlags |= scriptholder.event.event_flags;
         mEvents.push_back(scriptholder);//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    BuildEventIndex();
 }
 
 void SmartScript::GetScript()
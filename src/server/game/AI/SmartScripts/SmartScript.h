@@ -102,10 +102,12 @@ class TC_GAME_API SmartScript
         bool IsInPhase(uint32 p) const;
 
         void SortEvents(SmartAIEventList& events);
+        void BuildEventIndex();
         void RaisePriority(SmartScriptHolder& e);
         void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
         SmartAIEventList mEvents;
+        std::vector<std::pair<uint32 /*SMART_EVENT*/, uint32 /*index in mEvents*/>> mEventIndex; // sorted by event type, must be rebuilt whenever mEvents changes
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         ObjectGuid mTimedActionListInvoker;
@@ -28,6 +28,7 @@
 #include "Language.h"
 #include "Log.h"
 #include "Mail.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -501,7 +502,7 @@ void AuctionHouseMgr::PendingAuctionProcess(Player* player)
         do
         {
             AuctionEntry* AH = (*itrAH);
-            AH->expire_time = GameTime::GetGameTime();
+            GetAuctionsMapByHouseId(AH->houseId)->SetAuctionExpireTime(AH, GameTime::GetGameTime());
             AH->DeleteFromDB(trans);
             AH->SaveToDB(trans);
             ++itrAH;
@@ -545,7 +546,7 @@ void AuctionHouseMgr::UpdatePendingAuctions()
             {
                 AuctionEntry* AH = (*AHitr);
                 ++AHitr;
-                AH->expire_time = GameTime::GetGameTime();
+                GetAuctionsMapByHouseId(AH->houseId)->SetAuctionExpireTime(AH, GameTime::GetGameTime());
                 AH->DeleteFromDB(trans);
                 AH->SaveToDB(trans);
             }
@@ -558,9 +559,19 @@ void AuctionHouseMgr::UpdatePendingAuctions()
 
 void AuctionHouseMgr::Update()
 {
-    mHordeAuctions.Update();
-    mAllianceAuctions.Update();
-    mNeutralAuctions.Update();
+    TC_METRIC_TIMER("auctionhouse_update_time");
+
+    // all houses share one transaction, it is only started when something expires
+    CharacterDatabaseTransaction trans;
+    uint32 expiredCount = mHordeAuctions.Update(trans);
+    expiredCount += mAllianceAuctions.Update(trans);
+    expiredCount += mNeutralAuctions.Update(trans);
+
+    // Run DB changes
+    if (trans)
+        CharacterDatabase.CommitTransaction(trans);
+
+    TC_METRIC_VALUE("auctionhouse_expired", expiredCount);
 }
 
 AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTemplateId)
@@ -596,12 +607,41 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    ExpiryQueue.emplace(auction->expire_time, auction->Id);
+
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry))
+    {
+        AuctionsByClass[proto->Class][auction->Id] = auction;
+        AuctionsBySubClass[MAKE_PAIR32(proto->Class, proto->SubClass)][auction->Id] = auction;
+    }
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    ExpiryQueue.erase({ auction->expire_time, auction->Id });
+
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->itemEntry))
+    {
+        // drop the buckets of classes without auctions left, searches skip missing buckets
+        auto classItr = AuctionsByClass.find(proto->Class);
+        if (classItr != AuctionsByClass.end())
+        {
+            classItr->second.erase(auction->Id);
+            if (classItr->second.empty())
+                AuctionsByClass.erase(classItr);
+        }
+
+        auto subClassItr = AuctionsBySubClass.find(MAKE_PAIR32(proto->Class, proto->SubClass));
+        if (subClassItr != AuctionsBySubClass.end())
+        {
+            subClassItr->second.erase(auction->Id);
+            if (subClassItr->second.empty())
+                AuctionsBySubClass.erase(subClassItr);
+        }
+    }
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -610,14 +650,25 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+void AuctionHouseObject::SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime)
+{
+    if (AuctionsMap.count(auction->Id))
+    {
+        ExpiryQueue.erase({ auction->expire_time, auction->Id });
+        ExpiryQueue.emplace(expireTime, auction->Id);
+    }
+
+    auction->expire_time = expireTime;
+}
+
+uint32 AuctionHouseObject::Update(CharacterDatabaseTransaction& trans)
 {
     time_t curTime = GameTime::GetGameTime();
     ///- Handle expired auctions
 
     // If storage is empty, no need to update. next == NULL in this case.
     if (AuctionsMap.empty())
-        return;
+        return 0;
 
     // Clear expired throttled players
     for (PlayerGetAllThrottleMap::const_iterator itr = GetAllThrottleMap.begin(); itr != GetAllThrottleMap.end();)
@@ -628,18 +679,29 @@ void AuctionHouseObject::Update()
             ++itr;
     }
 
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    uint32 expiredCount = 0;
 
-    for (AuctionEntryMap::iterator it = AuctionsMap.begin(); it != AuctionsMap.end();)
+    ///- only auctions expired on next update, the queue is ordered by expire time
+    while (!ExpiryQueue.empty() && ExpiryQueue.begin()->first <= curTime + 60)
     {
         // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = it->second;
-        // Increment iterator due to AuctionEntry deletion
-        ++it;
+        AuctionEntry* auction = GetAuction(ExpiryQueue.begin()->second);
+        if (!auction)
+        {
+            ExpiryQueue.erase(ExpiryQueue.begin());
+            continue;
+        }
 
-        ///- filter auctions expired on next update
-        if (auction->expire_time > curTime + 60)
+        if (auction->expire_time != ExpiryQueue.begin()->first)
+        {
+            // expire_time was changed without SetAuctionExpireTime, queue the auction again under its current time
+            ExpiryQueue.erase(ExpiryQueue.begin());
+            ExpiryQueue.emplace(auction->expire_time, auction->Id);
             continue;
+        }
+
+        if (!trans)
+            trans = CharacterDatabase.BeginTransaction();
 
         ///- Either cancel the auction if there was no bidder
         if (auction->bidder == 0 && auction->bid == 0)
@@ -663,10 +725,10 @@ void AuctionHouseObject::Update()
 
         sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
         RemoveAuction(auction);
+        ++expiredCount;
     }
 
-    // Run DB changes
-    CharacterDatabase.CommitTransaction(trans);
+    return expiredCount;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -736,7 +798,11 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         return;
     }
 
-    for (AuctionEntryMap::const_iterator it = AuctionsMap.begin(); it != AuctionsMap.end(); ++it)
+    AuctionEntryMap const* auctions = GetAuctionsForSearch(itemClass, itemSubClass);
+    if (!auctions)
+        return;
+
+    for (AuctionEntryMap::const_iterator it = auctions->begin(); it != auctions->end(); ++it)
     {
         AuctionEntry* Aentry = it->second;
         // Skip expired auctions
@@ -768,63 +834,18 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
             continue;
 
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
-            continue;
-
         // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
         // No need to do any of this if no search term was entered
         if (!wsearchedname.empty())
         {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            // local name
-            if (localeConstant != LOCALE_enUS)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, localeConstant, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                //  even though the DBC names seem misleading
-
-                std::array<char const*, 16> const* suffix = nullptr;
-
-                if (propRefID < 0)
-                {
-                    ItemRandomSuffixEntry const* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
-                    if (itemRandSuffix)
-                        suffix = &itemRandSuffix->Name;
-                }
-                else
-                {
-                    ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-                    if (itemRandProp)
-                        suffix = &itemRandProp->Name;
-                }
-
-                // dbc local name
-                if (suffix)
-                {
-                    // Append the suffix (ie: of the Monkey) to the name using localization
-                    // or default enUS if localization is invalid
-                    name += ' ';
-                    name += (*suffix)[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
+            std::wstring const& name = GetSearchName(item, proto, localeConstant, locdbc_idx);
+            if (name.empty() || name.find(wsearchedname) == std::wstring::npos)
                 continue;
         }
 
+        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+            continue;
+
         // Add the item if no search term or if entered search term was found
         if (count < 50 && totalcount >= listfrom)
         {
@@ -835,6 +856,81 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     }
 }
 
+AuctionHouseObject::AuctionEntryMap const* AuctionHouseObject::GetAuctionsForSearch(uint32 itemClass, uint32 itemSubClass) const
+{
+    if (itemClass == 0xffffffff)
+        return &AuctionsMap;
+
+    if (itemSubClass != 0xffffffff)
+    {
+        auto itr = AuctionsBySubClass.find(MAKE_PAIR32(itemClass, itemSubClass));
+        return itr != AuctionsBySubClass.end() ? &itr->second : nullptr;
+    }
+
+    auto itr = AuctionsByClass.find(itemClass);
+    return itr != AuctionsByClass.end() ? &itr->second : nullptr;
+}
+
+std::wstring const& AuctionHouseObject::GetSearchName(Item* item, ItemTemplate const* proto, LocaleConstant locale, int dbcLocale)
+{
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    int32 propRefID = item->GetItemRandomPropertyId();
+
+    auto [itr, inserted] = SearchNameCache[locale].try_emplace(MAKE_PAIR64(proto->ItemId, uint32(propRefID)));
+    if (!inserted)
+        return itr->second;
+
+    std::string name = proto->Name1;
+    if (name.empty())
+        return itr->second;
+
+    // local name
+    if (locale != LOCALE_enUS)
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, locale, name);
+
+    if (propRefID)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+        //  even though the DBC names seem misleading
+
+        std::array<char const*, 16> const* suffix = nullptr;
+
+        if (propRefID < 0)
+        {
+            ItemRandomSuffixEntry const* itemRandSuffix = sItemRandomSuffixStore.LookupEntry(-propRefID);
+            if (itemRandSuffix)
+                suffix = &itemRandSuffix->Name;
+        }
+        else
+        {
+            ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
+            if (itemRandProp)
+                suffix = &itemRandProp->Name;
+        }
+
+        // dbc local name
+        if (suffix)
+        {
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            // or default enUS if localization is invalid
+            name += ' ';
+            name += (*suffix)[dbcLocale >= 0 ? dbcLocale : LOCALE_enUS];
+        }
+    }
+
+    // converting to lower case once, searches compare against the cached string
+    if (Utf8toWStr(name, itr->second))
+        wstrToLower(itr->second);
+    else
+        itr->second.clear();
+
+    return itr->second;
+}
+
 //this function inserts to WorldPacket auction's data
 bool AuctionEntry::BuildAuctionInfo(WorldPacket& data, Item* sourceItem) const
 {
@@ -18,17 +18,21 @@
 #ifndef _AUCTION_HOUSE_MGR_H
 #define _AUCTION_HOUSE_MGR_H
 
+#include "Common.h"
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
 #include "ObjectGuid.h"
+#include <array>
 #include <map>
 #include <set>
+#include <string>
 #include <unordered_map>
 
 class Item;
 class Player;
 class WorldPacket;
 struct AuctionHouseEntry;
+struct ItemTemplate;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
@@ -139,7 +143,10 @@ public:
 
     bool RemoveAuction(AuctionEntry* auction);
 
-    void Update();
+    void SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime);
+
+    // Expires due auctions, writing to trans (started on first use), returns the number of expired auctions
+    uint32 Update(CharacterDatabaseTransaction& trans);
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -149,8 +156,22 @@ public:
         uint32& count, uint32& totalcount, bool getall = false);
 
 private:
+    AuctionEntryMap const* GetAuctionsForSearch(uint32 itemClass, uint32 itemSubClass) const;
+    std::wstring const& GetSearchName(Item* item, ItemTemplate const* proto, LocaleConstant locale, int dbcLocale);
+
     AuctionEntryMap AuctionsMap;
 
+    // Auctions indexed by item class and by item class + subclass (MAKE_PAIR32(class, subclass)), same order as AuctionsMap
+    // so browsing a category only walks auctions of that category
+    std::unordered_map<uint32, AuctionEntryMap> AuctionsByClass;
+    std::unordered_map<uint32, AuctionEntryMap> AuctionsBySubClass;
+
+    // (expire time, auction id) of every auction, Update only walks the due ones from the front
+    std::set<std::pair<time_t, uint32>> ExpiryQueue;
+
+    // Lowercase localized item name with random suffix for name searches, keyed by MAKE_PAIR64(item entry, random property id)
+    std::array<std::unordered_map<uint64, std::wstring>, TOTAL_LOCALES> SearchNameCache;
+
     // Map of throttled players for GetAll, and throttle expiry time
     // Stored here, rather than player object to maintain persistence after logout
     PlayerGetAllThrottleMap GetAllThrottleMap;
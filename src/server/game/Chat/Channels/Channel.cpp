@@ -203,6 +203,9 @@ void Channel::JoinChannel(Player* player, std::string const& pass)
         _nextActivityUpdateTime = 0; // force activity update on next channel tick
 
     PlayerInfo& pinfo = _playersStore[guid];
+    pinfo.player = player;
+    pinfo.memberIndex = _members.size();
+    _members.push_back(player);
     pinfo.flags = MEMBER_FLAG_NONE;
     pinfo.invisible = !player->isGMVisible();
 
@@ -253,7 +256,7 @@ void Channel::LeaveChannel(Player* player, bool send)
 
     PlayerInfo& info = _playersStore.at(guid);
     bool changeowner = info.IsOwner();
-    _playersStore.erase(guid);
+    RemoveMember(guid);
 
     if (_announceEnabled && !player->GetSession()->HasPermission(rbac::RBAC_PERM_SILENTLY_JOIN_CHANNEL))
     {
@@ -352,7 +355,7 @@ void Channel::KickOrBan(Player const* player, std::string const& badname, bool b
         SendToAll(builder);
     }
 
-    _playersStore.erase(victim);
+    RemoveMember(victim);
     bad->LeftChannel(this);
 
     if (changeowner && _ownershipEnabled && !_playersStore.empty())
@@ -618,7 +621,7 @@ void Channel::List(Player const* player) const
     uint32 count  = 0;
     for (PlayerContainer::const_iterator i = _playersStore.begin(); i != _playersStore.end(); ++i)
     {
-        Player* member = ObjectAccessor::FindConnectedPlayer(i->first);
+        Player* member = i->second.player;
 
         // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
         // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
@@ -858,15 +861,33 @@ void Channel::LeaveNotify(ObjectGuid guid) const
         SendToAll(builder);
 }
 
+void Channel::RemoveMember(ObjectGuid guid)
+{
+    PlayerContainer::iterator itr = _playersStore.find(guid);
+    if (itr == _playersStore.end())
+        return;
+
+    // swap the last member into the freed slot
+    std::size_t index = itr->second.memberIndex;
+    if (index + 1 != _members.size())
+    {
+        Player* moved = _members.back();
+        _members[index] = moved;
+        _playersStore.at(moved->GetGUID()).memberIndex = index;
+    }
+
+    _members.pop_back();
+    _playersStore.erase(itr);
+}
+
 template<class Builder>
 void Channel::SendToAll(Builder& builder, ObjectGuid guid /*= ObjectGuid::Empty*/) const
 {
     Trinity::LocalizedPacketDo<Builder> localizer(builder);
 
-    for (PlayerContainer::const_iterator i = _playersStore.begin(); i != _playersStore.end(); ++i)
-        if (Player* player = ObjectAccessor::FindConnectedPlayer(i->first))
-            if (!guid || !player->GetSocial()->HasIgnore(guid))
-                localizer(player);
+    for (Player* player : _members)
+        if (!guid || !player->GetSocial()->HasIgnore(guid))
+            localizer(player);
 }
 
 template<class Builder>
@@ -874,10 +895,9 @@ void Channel::SendToAllButOne(Builder& builder, ObjectGuid who) const
 {
     Trinity::LocalizedPacketDo<Builder> localizer(builder);
 
-    for (PlayerContainer::const_iterator i = _playersStore.begin(); i != _playersStore.end(); ++i)
-        if (i->first != who)
-            if (Player* player = ObjectAccessor::FindConnectedPlayer(i->first))
-                localizer(player);
+    for (Player* player : _members)
+        if (player->GetGUID() != who)
+            localizer(player);
 }
 
 template<class Builder>
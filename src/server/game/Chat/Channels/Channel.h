@@ -120,6 +120,8 @@ class TC_GAME_API Channel
 {
     struct PlayerInfo
     {
+        Player* player;                 //< valid while on the channel, players leave all channels on logout
+        std::size_t memberIndex;        //< position of player in _members
         uint8 flags;
         bool invisible;
 
@@ -234,7 +236,10 @@ class TC_GAME_API Channel
         void SetModerator(ObjectGuid guid, bool set);
         void SetMute(ObjectGuid guid, bool set);
 
+        void RemoveMember(ObjectGuid guid);
+
         typedef std::map<ObjectGuid, PlayerInfo> PlayerContainer;
+        typedef std::vector<Player*> MemberContainer;
         typedef GuidUnorderedSet BannedContainer;
 
         bool _isDirty; // whether the channel needs to be saved to DB
@@ -251,6 +256,7 @@ class TC_GAME_API Channel
         std::string _channelName;
         std::string _channelPassword;
         PlayerContainer _playersStore;
+        MemberContainer _members;       //< flat copy of the players in _playersStore, walked when sending to everyone
         BannedContainer _bannedStore;
 
         AreaTableEntry const* _zoneEntry;
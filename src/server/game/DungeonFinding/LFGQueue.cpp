@@ -20,6 +20,7 @@
 #include "DBCStructure.h"
 #include "DBCStores.h"
 #include "GameTime.h"
+#include "Hash.h"
 #include "Group.h"
 #include "LFGQueue.h"
 #include "LFGMgr.h"
@@ -28,26 +29,30 @@
 namespace lfg
 {
 
-/**
-   Given a list of guids returns the concatenation using | as delimiter
-
-   @param[in]     check list of guids
-   @returns Concatenated string
-*/
-std::string ConcatenateGuids(GuidList const& check)
+LfgCompatibilityKey::LfgCompatibilityKey(GuidList const& check) : _guids(check.begin(), check.end())
 {
-    if (check.empty())
-        return "";
-
     // need the guids in order to avoid duplicates
-    GuidSet guids(check.begin(), check.end());
+    std::sort(_guids.begin(), _guids.end());
+    _guids.erase(std::unique(_guids.begin(), _guids.end()), _guids.end());
+}
 
-    std::ostringstream o;
+bool LfgCompatibilityKey::Contains(ObjectGuid guid) const
+{
+    return std::find(_guids.begin(), _guids.end(), guid) != _guids.end();
+}
 
-    GuidSet::const_iterator it = guids.begin();
-    o << it->GetRawValue();
-    for (++it; it != guids.end(); ++it)
-        o << '|' << it->GetRawValue();
+/**
+   Returns the concatenation of the guids using | as delimiter
+*/
+std::string LfgCompatibilityKey::ToString() const
+{
+    std::ostringstream o;
+    for (StorageType::const_iterator it = _guids.begin(); it != _guids.end(); ++it)
+    {
+        if (it != _guids.begin())
+            o << '|';
+        o << it->GetRawValue();
+    }
 
     return o.str();
 }
@@ -143,15 +148,11 @@ void LFGQueue::RemoveFromQueue(ObjectGuid guid)
     RemoveFromCurrentQueue(guid);
     RemoveFromCompatibles(guid);
 
-    std::ostringstream o;
-    o << guid.GetRawValue();
-    std::string sguid = o.str();
-
     LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
     for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
         if (itr->first != guid)
         {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
+            if (itr->second.bestCompatible.Contains(guid))
             {
                 itr->second.bestCompatible.clear();
                 FindBestCompatibleInQueue(itr);
@@ -237,43 +238,75 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 */
 void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
 {
-    std::stringstream out;
-    out << guid.GetRawValue();
-    std::string strGuid = out.str();
-
     TC_LOG_DEBUG("lfg.queue.data.compatibles.remove", "Removing {}", guid.ToString());
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
+
+    LfgCompatibleKeysContainer::iterator itKeys = CompatibleKeysStore.find(guid);
+    if (itKeys == CompatibleKeysStore.end())
+        return;
+
+    std::unordered_set<LfgCompatibilityKey const*> keys = std::move(itKeys->second);
+    CompatibleKeysStore.erase(itKeys);
+
+    for (LfgCompatibilityKey const* key : keys)
     {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
+        // unlink the entry from the other guids it contains before it gets destroyed
+        for (ObjectGuid member : *key)
+        {
+            if (member == guid)
+                continue;
+
+            LfgCompatibleKeysContainer::iterator itMember = CompatibleKeysStore.find(member);
+            if (itMember == CompatibleKeysStore.end())
+                continue;
+
+            itMember->second.erase(key);
+            if (itMember->second.empty())
+                CompatibleKeysStore.erase(itMember);
+        }
+
+        CompatibleMapStore.erase(CompatibleMapStore.find(*key));
     }
 }
 
+/**
+   Returns cached compatibility of a list of guids, creating and indexing a new entry if needed
+
+   @param[in]     key Sorted list of guids
+*/
+LfgCompatibilityData& LFGQueue::GetOrCreateCompatibilityData(LfgCompatibilityKey const& key)
+{
+    std::pair<LfgCompatibleContainer::iterator, bool> itr = CompatibleMapStore.try_emplace(key);
+    if (itr.second)
+        for (ObjectGuid guid : key)
+            CompatibleKeysStore[guid].insert(&itr.first->first);
+
+    return itr.first->second;
+}
+
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted list of guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles)
 {
-    LfgCompatibilityData& data = CompatibleMapStore[key];
+    LfgCompatibilityData& data = GetOrCreateCompatibilityData(key);
     data.compatibility = compatibles;
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    GetOrCreateCompatibilityData(key) = data;
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted list of guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -282,7 +315,7 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -325,8 +358,8 @@ uint8 LFGQueue::FindGroups()
 */
 LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    LfgCompatibilityKey guidsKey(check);
+    LfgCompatibility compatibles = GetCompatibles(guidsKey);
 
     TC_LOG_DEBUG("lfg.queue.match.check", "Guids: ({}): {} - all({})", GetDetailedMatchRoles(check), GetCompatibleString(compatibles), GetDetailedMatchRoles(all));
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
@@ -335,7 +368,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.check", "Guids: ({}) compatibles (cached) changed from bad states to match", GetDetailedMatchRoles(check));
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        SetCompatibles(guidsKey, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -363,7 +396,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
+    LfgCompatibilityKey guidsKey(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -386,8 +419,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) child {} not compatibles", strGuids, GetDetailedMatchRoles(check));
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) child {} not compatibles", guidsKey.ToString(), GetDetailedMatchRoles(check));
+            SetCompatibles(guidsKey, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -431,22 +464,22 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = itQueue->second.roles;
         LFGMgr::CheckGroupRoles(data.roles);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, guidsKey, data.roles);
+        SetCompatibilityData(guidsKey, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) More than one Lfggroup ({})", GetDetailedMatchRoles(check), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        SetCompatibles(guidsKey, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > MAX_GROUP_SIZE)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Too many players ({})", GetDetailedMatchRoles(check), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        SetCompatibles(guidsKey, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -474,7 +507,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) not compatible, {} players are ignoring each other", GetDetailedMatchRoles(check), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            SetCompatibles(guidsKey, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
@@ -486,7 +519,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
                 o << ", " << it->first.GetRawValue() << ": " << GetRolesString(it->second);
 
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Roles not compatible{}", GetDetailedMatchRoles(check), o.str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            SetCompatibles(guidsKey, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -506,7 +539,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (proposalDungeons.empty())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) No compatible dungeons{}", GetDetailedMatchRoles(check), o.str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            SetCompatibles(guidsKey, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -527,9 +560,9 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = proposalRoles;
 
         for (GuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), guidsKey, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(guidsKey, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -540,7 +573,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     if (!sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Group MATCH but can't create proposal!", GetDetailedMatchRoles(check));
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        SetCompatibles(guidsKey, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -582,7 +615,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     sLFGMgr->AddProposal(proposal);
 
     TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) MATCH! Group formed", GetDetailedMatchRoles(check));
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    SetCompatibles(guidsKey, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -674,7 +707,7 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
         {
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility);
+            o << "(" << itr->first.ToString() << "): " << GetCompatibleString(itr->second.compatibility);
             if (!itr->second.roles.empty())
             {
                 o << " (";
@@ -697,32 +730,28 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg.queue.compatibles.find", "{}", itrQueue->first.ToString());
-    std::ostringstream o;
-    o << itrQueue->first.GetRawValue();
-    std::string sguid = o.str();
 
-    for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
-        {
+    LfgCompatibleKeysContainer::const_iterator itKeys = CompatibleKeysStore.find(itrQueue->first);
+    if (itKeys == CompatibleKeysStore.end())
+        return;
+
+    for (LfgCompatibilityKey const* key : itKeys->second)
+    {
+        LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.find(*key);
+        if (itr != CompatibleMapStore.end() && itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
             UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
-        }
+    }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.size() <= queueData.bestCompatible.size())
         return;
 
     TC_LOG_DEBUG("lfg.queue.compatibles.update", "Changed ({}) to ({}) as best compatible group for {}",
-        queueData.bestCompatible, key, itrQueue->first.ToString());
+        queueData.bestCompatible.ToString(), key.ToString(), itrQueue->first.ToString());
 
     queueData.bestCompatible = key;
     queueData.tanks = LFG_TANKS_NEEDED;
@@ -741,3 +770,11 @@ void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQu
 }
 
 } // namespace lfg
+
+size_t std::hash<lfg::LfgCompatibilityKey>::operator()(lfg::LfgCompatibilityKey const& key) const
+{
+    size_t hashVal = 0;
+    for (ObjectGuid guid : key)
+        Trinity::hash_combine(hashVal, guid);
+    return hashVal;
+}
@@ -19,6 +19,9 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <boost/container/small_vector.hpp>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace lfg
 {
@@ -48,6 +51,42 @@ struct LfgCompatibilityData
     LfgRolesMap roles;
 };
 
+/// Sorted, duplicate free combination of queued guids, used as key of the compatibility cache
+class TC_GAME_API LfgCompatibilityKey
+{
+    public:
+        typedef boost::container::small_vector<ObjectGuid, LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED> StorageType;
+
+        LfgCompatibilityKey() { }
+        explicit LfgCompatibilityKey(GuidList const& check);
+
+        StorageType::const_iterator begin() const { return _guids.begin(); }
+        StorageType::const_iterator end() const { return _guids.end(); }
+        std::size_t size() const { return _guids.size(); }
+        bool empty() const { return _guids.empty(); }
+        void clear() { _guids.clear(); }
+
+        bool Contains(ObjectGuid guid) const;
+        std::string ToString() const;
+
+        bool operator==(LfgCompatibilityKey const& right) const { return _guids == right._guids; }
+        bool operator!=(LfgCompatibilityKey const& right) const { return !(*this == right); }
+
+    private:
+        StorageType _guids;
+};
+
+} // namespace lfg
+
+template<>
+struct std::hash<lfg::LfgCompatibilityKey>
+{
+    size_t operator()(lfg::LfgCompatibilityKey const& key) const;
+};
+
+namespace lfg
+{
+
 /// Stores player or group queue info
 struct LfgQueueData
 {
@@ -64,7 +103,7 @@ struct LfgQueueData
     uint8 dps;                                             ///< Dps needed
     LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
     LfgRolesMap roles;                                     ///< Selected Player Role/s
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgCompatibilityKey bestCompatible;                    ///< Best compatible combination of people queued
 };
 
 struct LfgWaitTime
@@ -75,7 +114,8 @@ struct LfgWaitTime
 };
 
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
+typedef std::unordered_map<LfgCompatibilityKey, LfgCompatibilityData> LfgCompatibleContainer;
+typedef std::unordered_map<ObjectGuid, std::unordered_set<LfgCompatibilityKey const*>> LfgCompatibleKeysContainer;
 typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -84,6 +124,10 @@ typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
 class TC_GAME_API LFGQueue
 {
     public:
+        LFGQueue() = default;
+
+        LFGQueue(LFGQueue const&) = delete;
+        LFGQueue& operator=(LFGQueue const&) = delete;
 
         // Add/Remove from queue
         std::string GetDetailedMatchRoles(GuidList const& check) const;
@@ -118,14 +162,15 @@ class TC_GAME_API LFGQueue
         void RemoveFromNewQueue(ObjectGuid guid);
         void RemoveFromCurrentQueue(ObjectGuid guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
+        void SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibilityKey const& key);
         void RemoveFromCompatibles(ObjectGuid guid);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData* GetCompatibilityData(LfgCompatibilityKey const& key);
+        LfgCompatibilityData& GetOrCreateCompatibilityData(LfgCompatibilityKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles);
 
         LfgCompatibility FindNewGroups(GuidList& check, GuidList& all);
         LfgCompatibility CheckCompatibility(GuidList check);
@@ -133,6 +178,7 @@ class TC_GAME_API LFGQueue
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
         LfgCompatibleContainer CompatibleMapStore;         ///< Compatible dungeons
+        LfgCompatibleKeysContainer CompatibleKeysStore;    ///< Keys of CompatibleMapStore each guid is part of
 
         LfgWaitTimesContainer waitTimesAvgStore;           ///< Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          ///< Average wait time to find a group queuing as tank
@@ -49,7 +49,10 @@ void Corpse::AddToWorld()
 {
     ///- Register the corpse for guid lookup
     if (!IsInWorld())
+    {
+        std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
         GetMap()->GetObjectsStore().Insert<Corpse>(GetGUID(), this);
+    }
 
     Object::AddToWorld();
 }
@@ -58,7 +61,10 @@ void Corpse::RemoveFromWorld()
 {
     ///- Remove the corpse from the accessor
     if (IsInWorld())
+    {
+        std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
         GetMap()->GetObjectsStore().Remove<Corpse>(GetGUID());
+    }
 
     WorldObject::RemoveFromWorld();
 }
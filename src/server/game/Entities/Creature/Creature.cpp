@@ -283,9 +283,12 @@ void Creature::AddToWorld()
     ///- Register the creature for guid lookup
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<Creature>(GetGUID(), this);
-        if (m_spawnId)
-            GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+        {
+            std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
+            GetMap()->GetObjectsStore().Insert<Creature>(GetGUID(), this);
+            if (m_spawnId)
+                GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+        }
 
         TC_LOG_DEBUG("entities.unit", "Adding creature {} with DBGUID {} to world in map {}", GetGUID().ToString(), m_spawnId, GetMap()->GetId());
 
@@ -312,6 +315,7 @@ void Creature::RemoveFromWorld()
 
         Unit::RemoveFromWorld();
 
+        std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
         if (m_spawnId)
             Trinity::Containers::MultimapErasePair(GetMap()->GetCreatureBySpawnIdStore(), m_spawnId, this);
 
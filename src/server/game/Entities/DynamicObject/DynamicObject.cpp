@@ -54,7 +54,10 @@ void DynamicObject::AddToWorld()
     ///- Register the dynamicObject for guid lookup and for caster
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<DynamicObject>(GetGUID(), this);
+        {
+            std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
+            GetMap()->GetObjectsStore().Insert<DynamicObject>(GetGUID(), this);
+        }
         WorldObject::AddToWorld();
         BindToCaster();
     }
@@ -77,6 +80,7 @@ void DynamicObject::RemoveFromWorld()
 
         UnbindFromCaster();
         WorldObject::RemoveFromWorld();
+        std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
         GetMap()->GetObjectsStore().Remove<DynamicObject>(GetGUID());
 
     }
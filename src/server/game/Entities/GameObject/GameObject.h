@@ -88,7 +88,8 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         explicit GameObject();
         ~GameObject();
 
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const override;
+        bool IsUpdateFieldTargetSpecific(uint16 index) const override;
+        uint32 GetUpdateFieldValue(uint16 index, Player const* target) const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
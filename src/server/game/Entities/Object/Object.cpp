@@ -194,7 +194,7 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
     buf << uint8(m_objectTypeId);
 
     BuildMovementUpdate(&buf, flags);
-    BuildValuesUpdate(updateType, &buf, target);
+    BuildValuesUpdate(updateType, &buf, target, GetUpdateFieldVisibility(target));
     data->AddUpdateBlock();
 }
 
@@ -219,11 +219,33 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* tar
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
 
-    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, target);
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, target, GetUpdateFieldVisibility(target));
 
     data->AddUpdateBlock();
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target, UpdateBlockCache& cache) const
+{
+    UpdateFieldVisibility visibility = GetUpdateFieldVisibility(target);
+
+    UpdateBlockCache::Block* block = cache.Find(visibility.VisibleFlag, visibility.ForcedFlags);
+    if (!block)
+    {
+        block = &cache.Add(visibility.VisibleFlag, visibility.ForcedFlags);
+        block->Data << uint8(UPDATETYPE_VALUES);
+        block->Data << GetPackGUID();
+
+        BuildValuesUpdate(UPDATETYPE_VALUES, &block->Data, target, visibility, &block->TargetFields);
+    }
+
+    ByteBuffer& buf = data->GetBuffer();
+    std::size_t blockPos = buf.wpos();
+    data->AddUpdateBlock(block->Data);
+
+    for (auto const& [fieldPos, index] : block->TargetFields)
+        buf.put<uint32>(blockPos + fieldPos, GetUpdateFieldValue(index, target));
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
 {
     data->AddOutOfRangeGUID(GetGUID());
@@ -458,7 +480,8 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 flags) const
         *data << int64(ToGameObject()->GetPackedLocalRotation());
 }
 
-void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* target) const
+void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const* target, UpdateFieldVisibility const& visibility,
+    std::vector<std::pair<std::size_t, uint16>>* targetFields /*= nullptr*/) const
 {
     if (!target)
         return;
@@ -466,21 +489,25 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player const*
     ByteBuffer fieldBuffer;
     UpdateMaskPacketBuilder updateMask(m_valuesCount);
 
-    uint32* flags = nullptr;
-    uint32 visibleFlag = GetUpdateFieldData(target, flags);
-    ASSERT(flags);
+    ASSERT(visibility.FieldMasks);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    ForEachUpdateField(updateType == UPDATETYPE_VALUES, *visibility.FieldMasks, visibility.VisibleFlag, visibility.ForcedFlags, visibility.ForcedIndex, [&](uint16 index)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
-        {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
-    }
+        updateMask.SetBit(index);
+
+        if (targetFields && IsUpdateFieldTargetSpecific(index))
+            targetFields->emplace_back(fieldBuffer.wpos(), index);
+
+        fieldBuffer << GetUpdateFieldValue(index, target);
+    });
 
     updateMask.AppendToPacket(data);
+
+    // field positions were recorded relative to fieldBuffer
+    if (targetFields)
+        for (std::pair<std::size_t, uint16>& targetField : *targetFields)
+            targetField.first += data->wpos();
+
     data->append(fieldBuffer);
 }
 
@@ -503,7 +530,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, UpdateBlockCache* cache /*= nullptr*/) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -514,12 +541,19 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (cache)
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *cache);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
-uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
+Object::UpdateFieldVisibility Object::GetUpdateFieldVisibility(Player const* target) const
 {
-    uint32 visibleFlag = UF_FLAG_PUBLIC;
+    UpdateFieldVisibility visibility;
+    visibility.ForcedFlags = _fieldNotifyFlags;
+
+    UpdateFieldFlagMasks const*& fieldMasks = visibility.FieldMasks;
+    uint32& visibleFlag = visibility.VisibleFlag;
 
     if (target == this)
         visibleFlag |= UF_FLAG_PRIVATE;
@@ -528,7 +562,7 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
     {
         case TYPEID_ITEM:
         case TYPEID_CONTAINER:
-            flags = ItemUpdateFieldFlags;
+            fieldMasks = &ItemUpdateFieldFlagMasks;
             if (((Item const*)this)->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER | UF_FLAG_ITEM_OWNER;
             break;
@@ -536,7 +570,7 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
         case TYPEID_PLAYER:
         {
             Player* plr = ToUnit()->GetCharmerOrOwnerPlayerOrPlayerItself();
-            flags = UnitUpdateFieldFlags;
+            fieldMasks = &UnitUpdateFieldFlagMasks;
             if (ToUnit()->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
 
@@ -546,20 +580,32 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
 
             if (plr && plr->IsInSameRaidWith(target))
                 visibleFlag |= UF_FLAG_PARTY_MEMBER;
+
+            // special info fields are always sent to targets allowed to see them, aura state when it has per caster states
+            visibility.ForcedFlags |= visibleFlag & UF_FLAG_SPECIAL_INFO;
+            if (HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK))
+                visibility.ForcedIndex = UNIT_FIELD_AURASTATE;
             break;
         }
         case TYPEID_GAMEOBJECT:
-            flags = GameObjectUpdateFieldFlags;
-            if (ToGameObject()->GetOwnerGUID() == target->GetGUID())
+        {
+            GameObject const* go = ToGameObject();
+            fieldMasks = &GameObjectUpdateFieldFlagMasks;
+            if (go->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
+
+            // group loot chests send their flags to everyone, locked for those not allowed to loot
+            if (go->GetGoType() == GAMEOBJECT_TYPE_CHEST && go->GetGOInfo()->chest.groupLootRules && go->HasLootRecipient())
+                visibility.ForcedIndex = GAMEOBJECT_FLAGS;
             break;
+        }
         case TYPEID_DYNAMICOBJECT:
-            flags = DynamicObjectUpdateFieldFlags;
+            fieldMasks = &DynamicObjectUpdateFieldFlagMasks;
             if (ToDynObject()->GetCasterGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
             break;
         case TYPEID_CORPSE:
-            flags = CorpseUpdateFieldFlags;
+            fieldMasks = &CorpseUpdateFieldFlagMasks;
             if (ToCorpse()->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
             break;
@@ -567,7 +613,7 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
             break;
     }
 
-    return visibleFlag;
+    return visibility;
 }
 
 bool Object::_LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count)
@@ -3518,9 +3564,10 @@ void WorldObject::UpdateObjectVisibility(bool /*forced*/)
 struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
+    UpdateBlockCache& i_blockCache;
     WorldObject& i_object;
     GuidSet plr_list;
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d, UpdateBlockCache& cache) : i_updateDatas(d), i_blockCache(cache), i_object(obj) { }
     void Visit(PlayerMapType &m)
     {
         Player* source = nullptr;
@@ -3577,7 +3624,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_blockCache);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -3587,7 +3634,8 @@ struct WorldObjectChangeAccumulator
 
 void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
 {
-    WorldObjectChangeAccumulator notifier(*this, data_map);
+    UpdateBlockCache cache;
+    WorldObjectChangeAccumulator notifier(*this, data_map, cache);
     //we must build packets for all visible players
     Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
 
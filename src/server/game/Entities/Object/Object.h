@@ -30,6 +30,7 @@
 #include "SharedDefines.h"
 #include "SpellDefines.h"
 #include "UniqueTrackablePtr.h"
+#include "UpdateFieldFlags.h"
 #include "UpdateFields.h"
 #include "UpdateMask.h"
 #include <list>
@@ -52,6 +53,7 @@ class SpellInfo;
 class TempSummon;
 class Transport;
 class Unit;
+class UpdateBlockCache;
 class UpdateData;
 class WorldObject;
 class WorldPacket;
@@ -98,6 +100,7 @@ class TC_GAME_API Object
         void SendUpdateToPlayer(Player* player);
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target, UpdateBlockCache& cache) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint32 flags = 0) const;
 
@@ -157,7 +160,7 @@ class TC_GAME_API Object
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         void SetIsNewObject(bool enable) { m_isNewObject = enable; }
         virtual void BuildUpdate(UpdateDataMapType&) { }
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, UpdateBlockCache* cache = nullptr) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= uint16(~flag); }
@@ -225,10 +228,59 @@ class TC_GAME_API Object
         std::string _ConcatFields(uint16 startIndex, uint16 size) const;
         [[nodiscard]] bool _LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count);
 
-        uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
+        // Which fields of this object target gets to see, everything except field values that only depends on these can be shared between targets
+        struct UpdateFieldVisibility
+        {
+            UpdateFieldFlagMasks const* FieldMasks = nullptr;
+            uint32 VisibleFlag = UF_FLAG_PUBLIC;
+            uint32 ForcedFlags = UF_FLAG_NONE;      // fields with these flags are always sent
+            Optional<uint16> ForcedIndex;           // field always sent
+        };
+
+        UpdateFieldVisibility GetUpdateFieldVisibility(Player const* target) const;
+
+        // Fields whose value sent to a target depends on the target, not only on its UpdateFieldVisibility
+        virtual bool IsUpdateFieldTargetSpecific(uint16 /*index*/) const { return false; }
+        virtual uint32 GetUpdateFieldValue(uint16 index, Player const* /*target*/) const { return m_uint32Values[index]; }
+
+        // Calls fn(index) in ascending order for every field that has to be written: fields having any of forcedFlags (and forcedIndex),
+        // and fields having any of visibleFlag that changed (values update) or are not zero (create update)
+        template<typename Fn>
+        void ForEachUpdateField(bool valuesUpdate, UpdateFieldFlagMasks const& fieldMasks, uint32 visibleFlag, uint32 forcedFlags, Optional<uint16> forcedIndex, Fn&& fn) const
+        {
+            for (uint32 block = 0; block < _changesMask.GetBlockCount(); ++block)
+            {
+                UpdateMask::BlockType fields = fieldMasks.GetBlock(visibleFlag, block);
+                if (valuesUpdate)
+                    fields &= _changesMask.GetBlock(block);
+                else
+                {
+                    for (UpdateMask::BlockType candidates = fields; candidates; candidates &= candidates - 1)
+                    {
+                        uint32 index = block * UpdateMask::BLOCK_BITS + std::countr_zero(candidates);
+                        if (index >= m_valuesCount || !m_uint32Values[index])
+                            fields &= ~UpdateMask::GetBlockFlag(index);
+                    }
+                }
+
+                fields |= fieldMasks.GetBlock(forcedFlags, block);
+                if (forcedIndex && UpdateMask::GetBlockIndex(*forcedIndex) == block)
+                    fields |= UpdateMask::GetBlockFlag(*forcedIndex);
+
+                for (; fields; fields &= fields - 1)
+                {
+                    uint16 index = block * UpdateMask::BLOCK_BITS + std::countr_zero(fields);
+                    if (index >= m_valuesCount)
+                        return;
+
+                    fn(index);
+                }
+            }
+        }
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
-        virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const;
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target, UpdateFieldVisibility const& visibility,
+            std::vector<std::pair<std::size_t, uint16>>* targetFields = nullptr) const;
 
         uint16 m_objectType;
 
@@ -35,29 +35,84 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid guid)
     m_outOfRangeGUIDs.insert(guid);
 }
 
-void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+    // deflateInit/deflateEnd allocate and release the whole compressor state (~256KB),
+    // keep one stream per map update thread alive and only deflateReset it between packets
+    class UpdateCompressionStream
+    {
+    public:
+        UpdateCompressionStream() : _stream(), _level(-1) { }
+
+        ~UpdateCompressionStream()
+        {
+            if (_level >= 0)
+                deflateEnd(&_stream);
+        }
+
+        UpdateCompressionStream(UpdateCompressionStream const&) = delete;
+        UpdateCompressionStream& operator=(UpdateCompressionStream const&) = delete;
+
+        z_stream* Acquire(int level)
+        {
+            int z_res;
+            if (_level == level)
+            {
+                z_res = deflateReset(&_stream);
+                if (z_res == Z_OK)
+                    return &_stream;
+
+                TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateReset) Error code: {} ({})", z_res, zError(z_res));
+            }
+
+            // first use on this thread, compression level changed by config reload or reset failure
+            if (_level >= 0)
+            {
+                deflateEnd(&_stream);
+                _level = -1;
+            }
+
+            _stream.zalloc = (alloc_func)nullptr;
+            _stream.zfree = (free_func)nullptr;
+            _stream.opaque = (voidpf)nullptr;
+
+            // default Z_BEST_SPEED (1)
+            z_res = deflateInit(&_stream, level);
+            if (z_res != Z_OK)
+            {
+                TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
+                return nullptr;
+            }
+
+            _level = level;
+            return &_stream;
+        }
+
+    private:
+        z_stream _stream;
+        int _level;
+    };
+
+    thread_local UpdateCompressionStream compressionStream;
+    thread_local std::array<UpdateData::CompressionStats, 10> compressionStats;
+}
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+{
+    int level = sWorld->getIntConfig(CONFIG_COMPRESSION);
+    z_stream* c_stream = compressionStream.Acquire(level);
+    if (!c_stream)
     {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
@@ -65,14 +120,14 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
@@ -80,15 +135,17 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        TC_LOG_ERROR("misc", "Can't compress update packet (zlib: deflateEnd) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
+
+    CompressionStats& stats = compressionStats[level];
+    ++stats.Packets;
+    stats.InputBytes += src_size;
+    stats.OutputBytes += c_stream->total_out;
+}
 
-    *dst_size = c_stream.total_out;
+std::array<UpdateData::CompressionStats, 10> UpdateData::ConsumeThreadCompressionStats()
+{
+    return std::exchange(compressionStats, {});
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -140,3 +197,40 @@ void UpdateData::Clear()
     m_outOfRangeGUIDs.clear();
     m_blockCount = 0;
 }
+
+namespace
+{
+    thread_local std::pair<uint32, uint32> updateBlockCacheStats;
+}
+
+UpdateBlockCache::~UpdateBlockCache()
+{
+    updateBlockCacheStats.first += m_hits;
+    updateBlockCacheStats.second += m_misses;
+}
+
+UpdateBlockCache::Block* UpdateBlockCache::Find(uint32 visibleFlag, uint32 forcedFlags)
+{
+    // an object rarely has more than a handful of observer classes (public, party, owner, self...)
+    for (Block& block : m_blocks)
+    {
+        if (block.VisibleFlag == visibleFlag && block.ForcedFlags == forcedFlags)
+        {
+            ++m_hits;
+            return &block;
+        }
+    }
+
+    return nullptr;
+}
+
+UpdateBlockCache::Block& UpdateBlockCache::Add(uint32 visibleFlag, uint32 forcedFlags)
+{
+    ++m_misses;
+    return m_blocks.emplace_back(visibleFlag, forcedFlags);
+}
+
+std::pair<uint32, uint32> UpdateBlockCache::ConsumeThreadStats()
+{
+    return std::exchange(updateBlockCacheStats, {});
+}
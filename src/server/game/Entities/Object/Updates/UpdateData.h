@@ -21,7 +21,10 @@
 #include "Define.h"
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
+#include <array>
 #include <set>
+#include <utility>
+#include <vector>
 
 class WorldPacket;
 
@@ -63,6 +66,7 @@ class UpdateData
         void AddOutOfRangeGUID(GuidSet& guids);
         void AddOutOfRangeGUID(ObjectGuid guid);
         void AddUpdateBlock() { ++m_blockCount; }
+        void AddUpdateBlock(ByteBuffer const& block) { m_data.append(block); ++m_blockCount; }
         ByteBuffer& GetBuffer() { return m_data; }
         bool BuildPacket(WorldPacket* packet);
         bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
@@ -70,6 +74,16 @@ class UpdateData
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        struct CompressionStats
+        {
+            uint32 Packets = 0;
+            uint64 InputBytes = 0;
+            uint64 OutputBytes = 0;
+        };
+
+        // Packets compressed on the calling thread since the previous call, indexed by compression level (1..9)
+        static std::array<CompressionStats, 10> ConsumeThreadCompressionStats();
+
     protected:
         uint32 m_blockCount;
         GuidSet m_outOfRangeGUIDs;
@@ -80,4 +94,37 @@ class UpdateData
         UpdateData(UpdateData const& right) = delete;
         UpdateData& operator=(UpdateData const& right) = delete;
 };
+
+// Values update blocks of one object, built once for every distinct observer visibility and copied to each observer
+// sharing it; fields whose value depends on the observer itself are patched in after the copy
+class UpdateBlockCache
+{
+    public:
+        struct Block
+        {
+            Block(uint32 visibleFlag, uint32 forcedFlags) : VisibleFlag(visibleFlag), ForcedFlags(forcedFlags), Data(0) { }
+
+            uint32 VisibleFlag;
+            uint32 ForcedFlags;
+            ByteBuffer Data;
+            std::vector<std::pair<std::size_t, uint16>> TargetFields;   // position in Data and index of observer dependent fields
+        };
+
+        UpdateBlockCache() : m_hits(0), m_misses(0) { }
+        ~UpdateBlockCache();
+
+        Block* Find(uint32 visibleFlag, uint32 forcedFlags);
+        Block& Add(uint32 visibleFlag, uint32 forcedFlags);
+
+        // Hits and misses of all caches destroyed on the calling thread since the previous call
+        static std::pair<uint32, uint32> ConsumeThreadStats();
+
+    private:
+        std::vector<Block> m_blocks;
+        uint32 m_hits;
+        uint32 m_misses;
+
+        UpdateBlockCache(UpdateBlockCache const& right) = delete;
+        UpdateBlockCache& operator=(UpdateBlockCache const& right) = delete;
+};
 #endif
@@ -1566,3 +1566,20 @@ uint32 CorpseUpdateFieldFlags[CORPSE_END] =
     UF_FLAG_DYNAMIC,                                        // CORPSE_FIELD_DYNAMIC_FLAGS
     UF_FLAG_NONE,                                           // CORPSE_FIELD_PAD
 };
+
+UpdateFieldFlagMasks::UpdateFieldFlagMasks(uint32 const* flags, uint32 fieldCount)
+{
+    for (std::vector<uint64>& fields : _fields)
+        fields.resize((fieldCount + 63) / 64);
+
+    for (uint32 index = 0; index < fieldCount; ++index)
+        for (uint32 flag = 0; flag < FLAG_COUNT; ++flag)
+            if (flags[index] & (1 << flag))
+                _fields[flag][index / 64] |= uint64(1) << (index % 64);
+}
+
+UpdateFieldFlagMasks const ItemUpdateFieldFlagMasks(ItemUpdateFieldFlags, CONTAINER_END);
+UpdateFieldFlagMasks const UnitUpdateFieldFlagMasks(UnitUpdateFieldFlags, PLAYER_END);
+UpdateFieldFlagMasks const GameObjectUpdateFieldFlagMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+UpdateFieldFlagMasks const DynamicObjectUpdateFieldFlagMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+UpdateFieldFlagMasks const CorpseUpdateFieldFlagMasks(CorpseUpdateFieldFlags, CORPSE_END);
@@ -20,6 +20,9 @@
 
 #include "UpdateFields.h"
 #include "Define.h"
+#include <array>
+#include <bit>
+#include <vector>
 
 enum UpdatefieldFlags
 {
@@ -41,4 +44,33 @@ TC_GAME_API extern uint32 GameObjectUpdateFieldFlags[GAMEOBJECT_END];
 TC_GAME_API extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 TC_GAME_API extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 
+// Fields of one update field table grouped by flag, 64 fields per block, so the fields
+// visible to a target can be selected a whole block at a time
+class TC_GAME_API UpdateFieldFlagMasks
+{
+public:
+    static constexpr uint32 FLAG_COUNT = 9;             // UF_FLAG_PUBLIC .. UF_FLAG_DYNAMIC
+
+    UpdateFieldFlagMasks(uint32 const* flags, uint32 fieldCount);
+
+    // Fields of block having any of the given flags
+    uint64 GetBlock(uint32 flags, uint32 block) const
+    {
+        uint64 fields = 0;
+        for (flags &= (1 << FLAG_COUNT) - 1; flags; flags &= flags - 1)
+            fields |= _fields[std::countr_zero(flags)][block];
+
+        return fields;
+    }
+
+private:
+    std::array<std::vector<uint64>, FLAG_COUNT> _fields;
+};
+
+TC_GAME_API extern UpdateFieldFlagMasks const ItemUpdateFieldFlagMasks;
+TC_GAME_API extern UpdateFieldFlagMasks const UnitUpdateFieldFlagMasks;
+TC_GAME_API extern UpdateFieldFlagMasks const GameObjectUpdateFieldFlagMasks;
+TC_GAME_API extern UpdateFieldFlagMasks const DynamicObjectUpdateFieldFlagMasks;
+TC_GAME_API extern UpdateFieldFlagMasks const CorpseUpdateFieldFlagMasks;
+
 #endif // _UPDATEFIELDFLAGS_H
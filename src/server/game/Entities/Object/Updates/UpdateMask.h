@@ -25,39 +25,64 @@
 class UpdateMask
 {
 public:
-    UpdateMask() : _bits(nullptr), _fieldCount(0) { }
+    using BlockType = uint64;
+
+    enum UpdateMaskCount
+    {
+        BLOCK_BITS = sizeof(BlockType) * 8,
+    };
+
+    UpdateMask() : _blocks(nullptr), _blockCount(0) { }
 
     void SetBit(uint32 index)
     {
-        _bits[index] = 1;
+        _blocks[GetBlockIndex(index)] |= GetBlockFlag(index);
     }
 
     void UnsetBit(uint32 index)
     {
-        _bits[index] = 0;
+        _blocks[GetBlockIndex(index)] &= ~GetBlockFlag(index);
     }
 
     bool GetBit(uint32 index) const
     {
-        return _bits[index] != 0;
+        return (_blocks[GetBlockIndex(index)] & GetBlockFlag(index)) != 0;
     }
 
     void SetCount(uint32 valuesCount)
     {
-        _bits = std::make_unique<uint8[]>(valuesCount);
-        std::uninitialized_fill_n(&_bits[0], valuesCount, 0);
-        _fieldCount = valuesCount;
+        _blockCount = CalculateBlockCount(valuesCount);
+        _blocks = std::make_unique<BlockType[]>(_blockCount);
+        std::uninitialized_fill_n(&_blocks[0], _blockCount, 0);
     }
 
     void Clear()
     {
-        if (_bits)
-            std::fill_n(&_bits[0], _fieldCount, 0);
+        if (_blocks)
+            std::fill_n(&_blocks[0], _blockCount, 0);
+    }
+
+    uint32 GetBlockCount() const { return _blockCount; }
+    BlockType GetBlock(uint32 block) const { return _blocks[block]; }
+
+    static constexpr uint32 CalculateBlockCount(uint32 fieldCount)
+    {
+        return (fieldCount + BLOCK_BITS - 1) / BLOCK_BITS;
+    }
+
+    static constexpr std::size_t GetBlockIndex(uint32 bit)
+    {
+        return bit / BLOCK_BITS;
+    }
+
+    static constexpr BlockType GetBlockFlag(uint32 bit)
+    {
+        return BlockType(1) << (bit % BLOCK_BITS);
     }
 
 private:
-    std::unique_ptr<uint8[]> _bits;
-    uint32 _fieldCount;
+    std::unique_ptr<BlockType[]> _blocks;
+    uint32 _blockCount;
 };
 
 class UpdateMaskPacketBuilder
@@ -70,7 +70,10 @@ void Pet::AddToWorld()
     if (!IsInWorld())
     {
         ///- Register the pet for guid lookup
-        GetMap()->GetObjectsStore().Insert<Pet>(GetGUID(), this);
+        {
+            std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
+            GetMap()->GetObjectsStore().Insert<Pet>(GetGUID(), this);
+        }
         Unit::AddToWorld();
         AIM_Initialize();
         if (ZoneScript* zoneScript = GetZoneScript() ? GetZoneScript() : GetInstanceScript())
@@ -96,6 +99,7 @@ void Pet::RemoveFromWorld()
     {
         ///- Don't call the function for Creature, normal mobs + totems go in a different storage
         Unit::RemoveFromWorld();
+        std::unique_lock<std::shared_mutex> storeLock = GetMap()->LockObjectsStore();
         GetMap()->GetObjectsStore().Remove<Pet>(GetGUID());
     }
 }
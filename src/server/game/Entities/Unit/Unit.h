@@ -1427,6 +1427,7 @@ class TC_GAME_API Unit : public WorldObject
         void _UnapplyAura(AuraApplication* aurApp, AuraRemoveMode removeMode);
         void _RemoveNoStackAurasDueToAura(Aura* aura, bool owned);
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        void _InvalidateAuraModifierCache(AuraType auraType) { m_modAurasCache.erase(auraType); }
         void _RemoveAllAuraStatMods();
         void _ApplyAllAuraStatMods();
 
@@ -1825,7 +1826,8 @@ class TC_GAME_API Unit : public WorldObject
 
         explicit Unit (bool isWorldObject);
 
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player const* target) const override;
+        bool IsUpdateFieldTargetSpecific(uint16 index) const override;
+        uint32 GetUpdateFieldValue(uint16 index, Player const* target) const override;
 
         void _UpdateSpells(uint32 time);
         void _DeleteRemovedAuras();
@@ -1877,6 +1879,16 @@ class TC_GAME_API Unit : public WorldObject
         uint32 m_removedAurasCount;
 
         std::array<AuraEffectList, TOTAL_AURAS> m_modAuras;
+        // results of the unconditional GetTotalAuraModifier/GetTotalAuraMultiplier/GetMax*AuraModifier queries,
+        // dropped whenever an effect of that type is registered, unregistered or changes amount
+        struct AuraModifierCache
+        {
+            Optional<int32> TotalModifier;
+            Optional<float> TotalMultiplier;
+            Optional<int32> MaxPositiveModifier;
+            Optional<int32> MaxNegativeModifier;
+        };
+        mutable std::unordered_map<uint32 /*AuraType*/, AuraModifierCache> m_modAurasCache;
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -127,6 +127,7 @@ namespace Trinity
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage; // copied once on first delivery and sent to everyone by reference
         uint32 i_phaseMask;
         float i_distSq;
         uint32 team;
@@ -157,7 +158,10 @@ namespace Trinity
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+            player->SendDirectMessage(i_sharedMessage);
         }
     };
 
@@ -165,6 +169,7 @@ namespace Trinity
     {
         Unit* i_source;
         WorldPacket const* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage;
         uint32 i_phaseMask;
         float i_distSq;
 
@@ -184,7 +189,10 @@ namespace Trinity
             if (player == i_source || !player->HaveAtClient(i_source) || player->IsFriendlyTo(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+            player->SendDirectMessage(i_sharedMessage);
         }
     };
 
@@ -244,6 +252,22 @@ namespace Trinity
         }
     };
 
+    // Circle around a point that contains every object a check can accept, padded by the object's own combat reach.
+    // Checks can expose it with "SearcherCullCircle GetCullCircle() const", searchers then reject objects outside it
+    // with a cheap 2d squared distance test before calling the full check (map, phase, transport and faction tests)
+    struct SearcherCullCircle
+    {
+        float X;
+        float Y;
+        float Radius;
+    };
+
+    template<class Check, class = void>
+    struct HasSearcherCullCircle : std::false_type { };
+
+    template<class Check>
+    struct HasSearcherCullCircle<Check, std::void_t<decltype(std::declval<Check const&>().GetCullCircle())>> : std::true_type { };
+
     // Generic base class to insert elements into arbitrary containers using push_back
     template<typename Type>
     class SearcherContainerResult
@@ -965,6 +989,8 @@ namespace Trinity
                 return false;
             }
 
+            SearcherCullCircle GetCullCircle() const { return { i_obj->GetPositionX(), i_obj->GetPositionY(), i_range + i_obj->GetCombatReach() }; }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1028,6 +1054,8 @@ namespace Trinity
                 return !i_playerOnly || u->GetTypeId() == TYPEID_PLAYER;
             }
 
+            SearcherCullCircle GetCullCircle() const { return { i_obj->GetPositionX(), i_obj->GetPositionY(), i_range + (i_incOwnRadius ? i_obj->GetCombatReach() : 0.0f) }; }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1071,6 +1099,8 @@ namespace Trinity
                 return u->IsInMap(_source) && u->InSamePhase(_source) && u->IsWithinDoubleVerticalCylinder(_source, searchRadius, searchRadius);
             }
 
+            SearcherCullCircle GetCullCircle() const { return { _source->GetPositionX(), _source->GetPositionY(), _range + (i_incOwnRadius ? _source->GetCombatReach() : 0.0f) }; }
+
         private:
             WorldObject const* _source;
             Unit const* _refUnit;
@@ -1094,6 +1124,8 @@ namespace Trinity
                 return false;
             }
 
+            SearcherCullCircle GetCullCircle() const { return { i_obj->GetPositionX(), i_obj->GetPositionY(), i_range + i_obj->GetCombatReach() }; }
+
         private:
             WorldObject const* i_obj;
             float i_range;
@@ -1117,6 +1149,8 @@ namespace Trinity
                 return false;
             }
 
+            SearcherCullCircle GetCullCircle() const { return { i_obj->GetPositionX(), i_obj->GetPositionY(), i_range + i_obj->GetCombatReach() }; }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1155,6 +1189,8 @@ namespace Trinity
                 return u->IsInMap(i_obj) && u->InSamePhase(i_obj) && u->IsWithinDoubleVerticalCylinder(i_obj, searchRadius, searchRadius);
             }
 
+            SearcherCullCircle GetCullCircle() const { return { i_obj->GetPositionX(), i_obj->GetPositionY(), i_range + (i_incOwnRadius ? i_obj->GetCombatReach() : 0.0f) }; }
+
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -1520,6 +1556,8 @@ namespace Trinity
                 return true;
             }
 
+            SearcherCullCircle GetCullCircle() const { return { _obj->GetPositionX(), _obj->GetPositionY(), _range + _obj->GetCombatReach() }; }
+
         private:
             WorldObject const* _obj;
             float _range;
@@ -1746,17 +1784,11 @@ namespace Trinity
         public:
             explicit LocalizedPacketDo(Builder& builder) : i_builder(builder) { }
 
-            ~LocalizedPacketDo()
-            {
-                for (size_t i = 0; i < i_data_cache.size(); ++i)
-                    delete i_data_cache[i];
-            }
-
             void operator()(Player* p);
 
         private:
             Builder& i_builder;
-            std::vector<WorldPacket*> i_data_cache;         // 0 = default, i => i-1 locale index
+            std::vector<std::shared_ptr<WorldPacket const>> i_data_cache; // 0 = default, i => i-1 locale index
     };
 
     // Prepare using Builder localized packets with caching and send to player
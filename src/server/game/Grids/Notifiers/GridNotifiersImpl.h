@@ -26,6 +26,7 @@
 #include "UpdateData.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include <array>
 
 template<class T>
 inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
@@ -39,6 +40,58 @@ inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 
 // SEARCHERS & LIST SEARCHERS & WORKERS
 
+namespace Trinity
+{
+    // Calls visitor for every object of m that check can accept until it returns false
+    // For checks with a cull circle the positions are copied into small arrays and tested in one tight
+    // loop the compiler can vectorize, only objects inside the circle reach the visitor
+    template<class T, class Check, class Visitor>
+    void VisitSearcherCandidates(GridRefManager<T>& m, Check const& check, Visitor&& visitor)
+    {
+        // game objects are matched against their model bounds by some checks, never cull them by position
+        if constexpr (HasSearcherCullCircle<Check>::value && !std::is_same_v<T, GameObject>)
+        {
+            constexpr std::size_t BatchSize = 32;
+
+            SearcherCullCircle const circle = check.GetCullCircle();
+            std::array<T*, BatchSize> objects;
+            std::array<float, BatchSize> x, y, radius;
+            std::array<uint8, BatchSize> inside;
+
+            auto itr = m.begin();
+            while (itr != m.end())
+            {
+                std::size_t count = 0;
+                for (; itr != m.end() && count < BatchSize; ++itr, ++count)
+                {
+                    T* object = itr->GetSource();
+                    objects[count] = object;
+                    x[count] = object->GetPositionX();
+                    y[count] = object->GetPositionY();
+                    radius[count] = circle.Radius + object->GetCombatReach();
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    float dx = x[i] - circle.X;
+                    float dy = y[i] - circle.Y;
+                    inside[i] = dx * dx + dy * dy <= radius[i] * radius[i];
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                    if (inside[i] && !visitor(objects[i]))
+                        return;
+            }
+        }
+        else
+        {
+            for (GridReference<T> const& ref : m)
+                if (!visitor(ref.GetSource()))
+                    return;
+        }
+    }
+}
+
 // WorldObject searchers & workers
 
 template <class Check, class Result>
@@ -51,16 +104,14 @@ void Trinity::WorldObjectSearcherBase<Check, Result>::Visit(GridRefManager<T>& m
     if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
         return;
 
-    for (GridReference<T> const& ref : m)
+    VisitSearcherCandidates(m, i_check, [this](T* object)
     {
-        if (i_check(ref.GetSource()))
-        {
-            this->Insert(ref.GetSource());
+        if (!i_check(object))
+            return true;
 
-            if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
-                return;
-        }
-    }
+        this->Insert(object);
+        return this->ShouldContinue() != WorldObjectSearcherContinuation::Return;
+    });
 }
 
 // Gameobject searchers
@@ -95,19 +146,14 @@ void Trinity::UnitSearcherBase<Check, Result>::VisitImpl(GridRefManager<T>& m)
     if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
         return;
 
-    for (GridReference<T> const& ref : m)
+    VisitSearcherCandidates(m, i_check, [this](T* object)
     {
-        if (!ref.GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!object->InSamePhase(i_phaseMask) || !i_check(object))
+            return true;
 
-        if (i_check(ref.GetSource()))
-        {
-            this->Insert(ref.GetSource());
-
-            if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
-                return;
-        }
-    }
+        this->Insert(object);
+        return this->ShouldContinue() != WorldObjectSearcherContinuation::Return;
+    });
 }
 
 // Creature searchers
@@ -118,19 +164,14 @@ void Trinity::CreatureSearcherBase<Check, Result>::Visit(CreatureMapType& m)
     if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
         return;
 
-    for (GridReference<Creature> const& ref : m)
+    VisitSearcherCandidates(m, i_check, [this](Creature* object)
     {
-        if (!ref.GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(ref.GetSource()))
-        {
-            this->Insert(ref.GetSource());
+        if (!object->InSamePhase(i_phaseMask) || !i_check(object))
+            return true;
 
-            if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
-                return;
-        }
-    }
+        this->Insert(object);
+        return this->ShouldContinue() != WorldObjectSearcherContinuation::Return;
+    });
 }
 
 // Player searchers
@@ -141,19 +182,14 @@ void Trinity::PlayerSearcherBase<Check, Result>::Visit(PlayerMapType& m)
     if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
         return;
 
-    for (GridReference<Player> const& ref : m)
+    VisitSearcherCandidates(m, i_check, [this](Player* object)
     {
-        if (!ref.GetSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(ref.GetSource()))
-        {
-            this->Insert(ref.GetSource());
+        if (!object->InSamePhase(i_phaseMask) || !i_check(object))
+            return true;
 
-            if (this->ShouldContinue() == WorldObjectSearcherContinuation::Return)
-                return;
-        }
-    }
+        this->Insert(object);
+        return this->ShouldContinue() != WorldObjectSearcherContinuation::Return;
+    });
 }
 
 template<class Builder>
@@ -161,7 +197,6 @@ void Trinity::LocalizedPacketDo<Builder>::operator()(Player* p)
 {
     LocaleConstant loc_idx = p->GetSession()->GetSessionDbLocaleIndex();
     uint32 cache_idx = loc_idx+1;
-    WorldPacket* data;
 
     // create if not cached yet
     if (i_data_cache.size() < cache_idx + 1 || !i_data_cache[cache_idx])
@@ -169,16 +204,15 @@ void Trinity::LocalizedPacketDo<Builder>::operator()(Player* p)
         if (i_data_cache.size() < cache_idx + 1)
             i_data_cache.resize(cache_idx + 1);
 
-        data = new WorldPacket();
+        std::shared_ptr<WorldPacket> data = std::make_shared<WorldPacket>();
 
         i_builder(*data, loc_idx);
 
-        i_data_cache[cache_idx] = data;
+        i_data_cache[cache_idx] = std::move(data);
     }
-    else
-        data = i_data_cache[cache_idx];
 
-    p->SendDirectMessage(data);
+    // every player with the same locale gets the same payload
+    p->SendDirectMessage(i_data_cache[cache_idx]);
 }
 
 template<class Builder>
@@ -1815,6 +1815,7 @@ void Group::UpdatePlayerOutOfRange(Player* player)
 
 void Group::BroadcastPacket(WorldPacket const* packet, bool ignorePlayersInBGRaid, int group /*= -1*/, ObjectGuid ignoredPlayer /*= ObjectGuid::Empty*/)
 {
+    std::shared_ptr<WorldPacket const> sharedPacket;
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* player = itr->GetSource();
@@ -1822,7 +1823,12 @@ void Group::BroadcastPacket(WorldPacket const* packet, bool ignorePlayersInBGRai
             continue;
 
         if (player->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            player->SendDirectMessage(packet);
+        {
+            if (!sharedPacket)
+                sharedPacket = std::make_shared<WorldPacket const>(*packet);
+
+            player->SendDirectMessage(sharedPacket);
+        }
     }
 }
 
@@ -65,68 +65,60 @@ GridMap::LoadResult GridMap::loadData(char const* filename)
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    _file = Trinity::MappedFile::Open(filename);
+    if (!_file)
         return LoadResult::FileDoesNotExist;
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    map_fileheader header;
+    if (!_file->Read(0, header))
     {
-        fclose(in);
+        unloadData();
         return LoadResult::InvalidFile;
     }
 
     if (header.mapMagic == MapMagic && header.versionMagic == MapVersionMagic)
     {
         // load up area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset, header.areaMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // load up height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(header.heightMapOffset, header.heightMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // load up liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadLiquidData(header.liquidMapOffset, header.liquidMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // loadup holes data (if any. check header.holesOffset)
-        if (header.holesSize && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesSize && !loadHolesData(header.holesOffset, header.holesSize))
         {
             TC_LOG_ERROR("maps", "Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
-        fclose(in);
         return LoadResult::Ok;
     }
 
     TC_LOG_ERROR("maps", "Map file '{}' is from an incompatible map version ({} v{}), {} v{} is expected. Please pull your source, recompile tools and recreate maps using the updated mapextractor, then replace your old map files with new files. If you still have problems search on forum for error TCE00018.",
         filename, std::string_view(header.mapMagic.data(), 4), header.versionMagic, std::string_view(MapMagic.data(), 4), MapVersionMagic);
-    fclose(in);
+    unloadData();
     return LoadResult::InvalidFile;
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
     delete[] _minHeightPlanes;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    delete[] _holes;
     _areaMap = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -136,64 +128,80 @@ void GridMap::unloadData()
     _liquidMap  = nullptr;
     _holes = nullptr;
     _gridGetHeight = &GridMap::getHeightFromFlat;
+    _unalignedData.clear();
+    _file = nullptr;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template<typename T>
+T const* GridMap::getArray(uint32 offset, uint32 count)
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (T const* data = _file->GetArray<T>(offset, count))
+        return data;
+
+    if (offset > _file->GetSize() || (_file->GetSize() - offset) / sizeof(T) < count)
+        return nullptr;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.areaMagic != MapAreaMagic)
+    // arrays placed after an odd sized one (uint8 heights) are not aligned in the file, these get a copy
+    std::shared_ptr<T[]> copy(new T[count]);
+    memcpy(copy.get(), _file->GetData() + offset, count * sizeof(T));
+    _unalignedData.push_back(copy);
+    return copy.get();
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
+{
+    map_areaHeader header;
+    if (!_file->Read(offset, header) || header.areaMagic != MapAreaMagic)
         return false;
 
     _gridArea = header.gridArea;
     if (!header.flags.HasFlag(map_areaHeaderFlags::NoArea))
     {
-        _areaMap = new uint16[16 * 16];
-        if (fread(_areaMap, sizeof(uint16), 16*16, in) != 16*16)
+        _areaMap = getArray<uint16>(offset + sizeof(header), 16 * 16);
+        if (!_areaMap)
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.heightMagic != MapHeightMagic)
+    if (!_file->Read(offset, header) || header.heightMagic != MapHeightMagic)
         return false;
 
+    offset += sizeof(header);
+
     _gridHeight = header.gridHeight;
     if (!header.flags.HasFlag(map_heightHeaderFlags::NoHeight))
     {
         if (header.flags.HasFlag(map_heightHeaderFlags::HeightAsInt16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            m_uint16_V9 = getArray<uint16>(offset, 129*129);
+            m_uint16_V8 = getArray<uint16>(offset + sizeof(uint16) * 129*129, 128*128);
+            if (!m_uint16_V9 || !m_uint16_V8)
                 return false;
+            offset += sizeof(uint16) * (129*129 + 128*128);
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if (header.flags.HasFlag(map_heightHeaderFlags::HeightAsInt8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            m_uint8_V9 = getArray<uint8>(offset, 129*129);
+            m_uint8_V8 = getArray<uint8>(offset + sizeof(uint8) * 129*129, 128*128);
+            if (!m_uint8_V9 || !m_uint8_V8)
                 return false;
+            offset += sizeof(uint8) * (129*129 + 128*128);
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            m_V9 = getArray<float>(offset, 129*129);
+            m_V8 = getArray<float>(offset + sizeof(float) * 129*129, 128*128);
+            if (!m_V9 || !m_V8)
                 return false;
+            offset += sizeof(float) * (129*129 + 128*128);
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
     }
@@ -204,8 +212,7 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         std::array<int16, 9> maxHeights;
         std::array<int16, 9> minHeights;
-        if (fread(maxHeights.data(), sizeof(int16), maxHeights.size(), in) != maxHeights.size() ||
-            fread(minHeights.data(), sizeof(int16), minHeights.size(), in) != minHeights.size())
+        if (!_file->Read(offset, maxHeights) || !_file->Read(offset + sizeof(maxHeights), minHeights))
             return false;
 
         static uint32 constexpr indices[8][3] =
@@ -245,14 +252,14 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.liquidMagic != MapLiquidMagic)
+    if (!_file->Read(offset, header) || header.liquidMagic != MapLiquidMagic)
         return false;
 
+    offset += sizeof(header);
+
     _liquidGlobalEntry = header.liquidType;
     _liquidGlobalFlags = header.liquidFlags;
     _liquidOffX  = header.offsetX;
@@ -263,33 +270,29 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!header.flags.HasFlag(map_liquidHeaderFlags::NoType))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
+        _liquidEntry = getArray<uint16>(offset, 16*16);
+        if (!_liquidEntry)
             return false;
+        offset += sizeof(uint16) * 16*16;
 
-        _liquidFlags = new map_liquidHeaderTypeFlags[16*16];
-        if (fread(_liquidFlags, sizeof(map_liquidHeaderTypeFlags), 16*16, in) != 16*16)
+        _liquidFlags = getArray<map_liquidHeaderTypeFlags>(offset, 16*16);
+        if (!_liquidFlags)
             return false;
+        offset += sizeof(map_liquidHeaderTypeFlags) * 16*16;
     }
     if (!header.flags.HasFlag(map_liquidHeaderFlags::NoHeight))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        _liquidMap = getArray<float>(offset, uint32(_liquidWidth) * uint32(_liquidHeight));
+        if (!_liquidMap)
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-
-    _holes = new uint16[16 * 16];
-    if (fread(_holes, sizeof(uint16), 16 * 16, in) != 16 * 16)
-        return false;
-
-    return true;
+    _holes = getArray<uint16>(offset, 16 * 16);
+    return _holes != nullptr;
 }
 
 uint16 GridMap::getArea(float x, float y) const
@@ -413,7 +416,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -483,7 +486,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -20,8 +20,10 @@
 
 #include "Define.h"
 #include "MapDefines.h"
+#include "MappedFile.h"
 #include "Optional.h"
-#include <cstdio>
+#include <memory>
+#include <vector>
 
 struct LiquidData;
 enum ZLiquidStatus : uint32;
@@ -30,15 +32,19 @@ namespace G3D { class Plane; }
 class TC_GAME_API GridMap
 {
     uint32  _flags;
+    // The mapped .map file, shared by every instance of the map. All data arrays below point into it
+    std::shared_ptr<Trinity::MappedFile const> _file;
+    std::vector<std::shared_ptr<void const>> _unalignedData;
+
     union{
-        float* m_V9;
-        uint16* m_uint16_V9;
-        uint8* m_uint8_V9;
+        float const* m_V9;
+        uint16 const* m_uint16_V9;
+        uint8 const* m_uint8_V9;
     };
     union{
-        float* m_V8;
-        uint16* m_uint16_V8;
-        uint8* m_uint8_V8;
+        float const* m_V8;
+        uint16 const* m_uint16_V8;
+        uint8 const* m_uint8_V8;
     };
     G3D::Plane* _minHeightPlanes;
     // Height level data
@@ -46,13 +52,13 @@ class TC_GAME_API GridMap
     float _gridIntHeightMultiplier;
 
     // Area data
-    uint16* _areaMap;
+    uint16 const* _areaMap;
 
     // Liquid data
     float _liquidLevel;
-    uint16* _liquidEntry;
-    map_liquidHeaderTypeFlags* _liquidFlags;
-    float* _liquidMap;
+    uint16 const* _liquidEntry;
+    map_liquidHeaderTypeFlags const* _liquidFlags;
+    float const* _liquidMap;
     uint16 _gridArea;
     uint16 _liquidGlobalEntry;
     map_liquidHeaderTypeFlags _liquidGlobalFlags;
@@ -61,12 +67,14 @@ class TC_GAME_API GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
 
-    uint16* _holes;
+    uint16 const* _holes;
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
-    bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+    template<typename T>
+    T const* getArray(uint32 offset, uint32 count);
+    bool loadAreaData(uint32 offset, uint32 size);
+    bool loadHeightData(uint32 offset, uint32 size);
+    bool loadLiquidData(uint32 offset, uint32 size);
+    bool loadHolesData(uint32 offset, uint32 size);
     bool isHole(int row, int col) const;
 
     // Get height functions and pointers
@@ -31,6 +31,7 @@
 #include "InstanceScript.h"
 #include "Log.h"
 #include "MapInstanced.h"
+#include "MapIslands.h"
 #include "MapManager.h"
 #include "Metric.h"
 #include "MiscPackets.h"
@@ -39,10 +40,13 @@
 #include "ObjectAccessor.h"
 #include "ObjectGridLoader.h"
 #include "ObjectMgr.h"
+#include "PathCache.h"
+#include "PathSearchQueue.h"
 #include "Pet.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
+#include "UpdateData.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
@@ -56,6 +60,7 @@
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
 #define MAX_CREATURE_ATTACK_RADIUS  (45.0f * sWorld->GetRate(RATE_CREATURE_AGGRO))
+#define ISLAND_HALO_MARGIN      40.0f
 
 GridState* si_GridStates[MAX_GRID_STATE];
 
@@ -162,6 +167,7 @@ void Map::LoadMapAndVMap(int32 gx, int32 gy)
     {
         LoadVMap(gx, gy);
         LoadMMap(gx, gy);
+        PrefetchAdjacentMMaps(gx, gy);
     }
 }
 
@@ -218,6 +224,19 @@ void Map::LoadMMap(int32 gx, int32 gy)
         TC_LOG_WARN("mmaps.tiles", "Could not load MMAP name:{}, id:{}, x:{}, y:{} (mmap rep.: x:{}, y:{})", GetMapName(), GetId(), gx, gy, gx, gy);
 }
 
+void Map::PrefetchAdjacentMMaps(int32 gx, int32 gy)
+{
+    if (!DisableMgr::IsPathfindingEnabled(GetId()) || !sWorld->getBoolConfig(CONFIG_MMAP_PREFETCH_ADJACENT_TILES))
+        return;
+
+    // grids next to a loaded one are the most likely to be loaded next, get their tiles off disk meanwhile
+    MMAP::MMapManager* mmmgr = MMAP::MMapFactory::createOrGetMMapManager();
+    for (int32 x = std::max(gx - 1, 0); x <= std::min(gx + 1, MAX_NUMBER_OF_GRIDS - 1); ++x)
+        for (int32 y = std::max(gy - 1, 0); y <= std::min(gy + 1, MAX_NUMBER_OF_GRIDS - 1); ++y)
+            if ((x != gx || y != gy) && !_gridMap[x][y] && _gridFileExists[GetBitsetIndex(x, y)])
+                mmmgr->prefetchMap(sWorld->GetDataPath(), GetId(), x, y);
+}
+
 void Map::UnloadMap(int32 gx, int32 gy)
 {
     _gridMap[gx][gy] = nullptr;
@@ -249,11 +268,13 @@ void Map::DeleteStateMachine()
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent):
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false),
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
-m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), _pathCache(std::make_unique<PathCache>()),
+_pathSearches(std::make_unique<PathSearchQueue>()), _updatingIslands(false),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
-i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _respawnCheckTimer(0)
+i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _respawnCheckTimer(0),
+_updateCostEstimate(0)
 {
     m_parentMap = (_parent ? _parent : this);
     for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
@@ -510,6 +531,9 @@ void Map::EnsureGridLoadedForActiveObject(Cell const& cell, WorldObject const* o
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(Cell const& cell)
 {
+    // loading a grid adds its objects to the map wide object stores
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -612,6 +636,8 @@ void Map::InitializeObject(GameObject* obj)
 template<class T>
 bool Map::AddToMap(T* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     /// @todo Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -745,6 +771,154 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
     ++_zonePlayerCountMap[newZone];
 }
 
+void Map::GetFarUpdateSourcesOf(Player* player, std::vector<WorldObject*>& sources)
+{
+    // If player is using far sight or mind vision, visit that object too
+    if (WorldObject* viewPoint = player->GetViewpoint())
+        sources.push_back(viewPoint);
+
+    // Handle updates for creatures in combat with player and are more than 60 yards away
+    if (player->IsInCombat())
+    {
+        for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
+            if (Creature* unit = pair.second->GetOther(player)->ToCreature())
+                if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                    sources.push_back(unit);
+    }
+
+    { // Update any creatures that own auras the player has applications of
+        std::unordered_set<Unit*> casters;
+        for (std::pair<uint32, AuraApplication*> pair : player->GetAppliedAuras())
+        {
+            if (Unit* caster = pair.second->GetBase()->GetCaster())
+                if (caster->GetTypeId() != TYPEID_PLAYER && !caster->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                    if (casters.insert(caster).second)
+                        sources.push_back(caster);
+        }
+    }
+
+    // Update player's summons
+    for (ObjectGuid const& summonGuid : player->m_SummonSlot)
+        if (!summonGuid.IsEmpty())
+            if (Creature* unit = GetCreature(summonGuid))
+                if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                    sources.push_back(unit);
+}
+
+bool Map::CanUpdateIslands() const
+{
+    // instances and battlegrounds are small enough to be updated by a single thread
+    if (Instanceable())
+        return false;
+
+    uint32 minPlayers = sWorld->getIntConfig(CONFIG_MAP_UPDATE_ISLANDS_MIN_PLAYERS);
+    return minPlayers && m_mapRefManager.getSize() >= minPlayers && sMapMgr->GetMapUpdater()->activated();
+}
+
+void Map::UpdateIslands(uint32 diff)
+{
+    // an updated object acts on others within its visibility range at most (gigantic objects are seen from farther away),
+    // plus a margin for the reach of melee and most spells; sources closer than twice that share an island
+    float const haloRange = std::max(GetVisibilityRange(), VISIBILITY_DISTANCE_GIGANTIC) + ISLAND_HALO_MARGIN;
+    uint32 const haloCells = uint32(std::ceil(haloRange / SIZE_OF_GRID_CELL));
+    if (!_islands)
+        _islands = std::make_unique<MapIslandPartition>(haloCells);
+    else
+        _islands->SetHaloCells(haloCells);
+
+    std::vector<WorldObject*> farSources;
+    std::unordered_map<Group const*, uint32> groupSources;
+
+    // players are still updated one after another, they reach across the whole map (groups, trades, mail...)
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->GetSource();
+
+        if (!player || !player->IsInWorld())
+            continue;
+
+        // update players at tick
+        player->Update(diff);
+
+        // the player may have left the map during its update
+        if (!player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        uint32 playerSource = _islands->AddSource(Cell::CalculateCellArea(player->GetPositionX(), player->GetPositionY(), player->GetGridActivationRange()));
+
+        // kills reward and loot for the whole group, its members on this map are updated by the same thread
+        if (Group const* group = player->GetGroup())
+        {
+            auto itr = groupSources.emplace(group, playerSource).first;
+            if (itr->second != playerSource)
+                _islands->Link(itr->second, playerSource);
+        }
+
+        // far sources act on the player (or the player on them), they must be updated by the same thread
+        farSources.clear();
+        GetFarUpdateSourcesOf(player, farSources);
+        for (WorldObject* source : farSources)
+        {
+            if (!source->IsPositionValid())
+                continue;
+
+            _islands->AddSource(Cell::CalculateCellArea(source->GetPositionX(), source->GetPositionY(), source->GetGridActivationRange()), playerSource);
+        }
+    }
+
+    for (WorldObject* obj : m_activeNonPlayers)
+    {
+        if (!obj || !obj->IsInWorld() || !obj->IsPositionValid())
+            continue;
+
+        _islands->AddSource(Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange()));
+    }
+
+    uint32 islandCount = _islands->Build();
+    TC_METRIC_VALUE("map_update_islands", uint64(islandCount), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+
+    // cells are assigned to the island of the first source activating them, same as VisitNearbyCellsOf marks them
+    std::vector<std::vector<Cell>> islandCells(islandCount);
+    for (uint32 source = 0; source < _islands->GetSourceCount(); ++source)
+    {
+        CellArea const& area = _islands->GetArea(source);
+        std::vector<Cell>& cells = islandCells[_islands->GetIsland(source)];
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                if (isCellMarked(cell_id))
+                    continue;
+
+                markCell(cell_id);
+                Cell cell(CellCoord(x, y));
+                cell.SetNoCreate();
+                cells.push_back(cell);
+            }
+        }
+    }
+
+    _islands->Clear();
+
+    // queries must find the tree balanced, see InsertGameObjectModel
+    Balance();
+
+    _updatingIslands = true;
+    sMapMgr->GetMapUpdater()->run_parallel(islandCells.size(), [this, diff, &islandCells](std::size_t island)
+    {
+        Trinity::ObjectUpdater updater(diff);
+        TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> grid_object_update(updater);
+        TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> world_object_update(updater);
+        for (Cell const& cell : islandCells[island])
+        {
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
+        }
+    });
+    _updatingIslands = false;
+}
+
 void Map::Update(uint32 diff)
 {
     _dynamicTree.update(diff);
@@ -773,79 +947,49 @@ void Map::Update(uint32 diff)
     /// update active cells around players and active objects
     resetMarkedCells();
 
-    Trinity::ObjectUpdater updater(diff);
-    // for creature
-    TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
-    // for pets
-    TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
-
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    if (CanUpdateIslands())
+        UpdateIslands(diff);
+    else
     {
-        Player* player = m_mapRefIter->GetSource();
-
-        if (!player || !player->IsInWorld())
-            continue;
+        Trinity::ObjectUpdater updater(diff);
+        // for creature
+        TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+        // for pets
+        TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-        // update players at tick
-        player->Update(diff);
-
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        std::vector<WorldObject*> farSources;
 
-        // If player is using far sight or mind vision, visit that object too
-        if (WorldObject* viewPoint = player->GetViewpoint())
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
-
-        // Handle updates for creatures in combat with player and are more than 60 yards away
-        if (player->IsInCombat())
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            std::vector<Unit*> toVisit;
-            for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
-                if (Creature* unit = pair.second->GetOther(player)->ToCreature())
-                    if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        toVisit.push_back(unit);
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
-        }
+            Player* player = m_mapRefIter->GetSource();
 
-        { // Update any creatures that own auras the player has applications of
-            std::unordered_set<Unit*> toVisit;
-            for (std::pair<uint32, AuraApplication*> pair : player->GetAppliedAuras())
-            {
-                if (Unit* caster = pair.second->GetBase()->GetCaster())
-                    if (caster->GetTypeId() != TYPEID_PLAYER && !caster->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        toVisit.insert(caster);
-            }
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
-        }
+            if (!player || !player->IsInWorld())
+                continue;
 
-        { // Update player's summons
-            std::vector<Unit*> toVisit;
+            // update players at tick
+            player->Update(diff);
 
-            // Totems
-            for (ObjectGuid const& summonGuid : player->m_SummonSlot)
-                if (!summonGuid.IsEmpty())
-                    if (Creature* unit = GetCreature(summonGuid))
-                        if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                            toVisit.push_back(unit);
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
 
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+            farSources.clear();
+            GetFarUpdateSourcesOf(player, farSources);
+            for (WorldObject* source : farSources)
+                VisitNearbyCellsOf(source, grid_object_update, world_object_update);
         }
-    }
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
-    {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
+        // non-player active objects, increasing iterator in the loop in case of object removal
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
 
-        if (!obj || !obj->IsInWorld())
-            continue;
+            if (!obj || !obj->IsInWorld())
+                continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        }
     }
 
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
@@ -861,6 +1005,19 @@ void Map::Update(uint32 diff)
 
     SendObjectUpdates();
 
+    // packets compressed by helpers of a parallel send are reported by the map update they run next
+    std::array<UpdateData::CompressionStats, 10> compressionStats = UpdateData::ConsumeThreadCompressionStats();
+    for (std::size_t level = 0; level < compressionStats.size(); ++level)
+    {
+        UpdateData::CompressionStats const& stats = compressionStats[level];
+        if (!stats.Packets)
+            continue;
+
+        TC_METRIC_VALUE("update_compressed_packets", stats.Packets, TC_METRIC_TAG("level", std::to_string(level)));
+        TC_METRIC_VALUE("update_compressed_input_bytes", stats.InputBytes, TC_METRIC_TAG("level", std::to_string(level)));
+        TC_METRIC_VALUE("update_compressed_output_bytes", stats.OutputBytes, TC_METRIC_TAG("level", std::to_string(level)));
+    }
+
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
@@ -887,6 +1044,36 @@ void Map::Update(uint32 diff)
 
     sScriptMgr->OnMapUpdate(this, diff);
 
+    if (uint32 pathCacheDuration = sWorld->getIntConfig(CONFIG_MMAP_PATH_CACHE_DURATION))
+    {
+        _pathCache->Update(GameTime::GetGameTimeMS(), pathCacheDuration);
+
+        uint32 pathCacheHits, pathCacheMisses;
+        uint64 pathCacheTimeSaved;
+        _pathCache->ConsumeStats(pathCacheHits, pathCacheMisses, pathCacheTimeSaved);
+        if (pathCacheHits || pathCacheMisses)
+        {
+            TC_METRIC_VALUE("path_cache_hits", pathCacheHits, TC_METRIC_TAG("map_id", std::to_string(GetId())));
+            TC_METRIC_VALUE("path_cache_misses", pathCacheMisses, TC_METRIC_TAG("map_id", std::to_string(GetId())));
+            TC_METRIC_VALUE("path_cache_time_saved", pathCacheTimeSaved, TC_METRIC_TAG("map_id", std::to_string(GetId())));
+        }
+    }
+
+    if (PathSearchQueue::HasWorkers())
+    {
+        std::vector<uint32> pathSearchLatencies = _pathSearches->ConsumeLatencies();
+        if (!pathSearchLatencies.empty())
+        {
+            std::sort(pathSearchLatencies.begin(), pathSearchLatencies.end());
+            auto percentile = [&](uint32 p) { return pathSearchLatencies[(pathSearchLatencies.size() - 1) * p / 100]; };
+            TC_METRIC_VALUE("path_search_latency_p50", percentile(50), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+            TC_METRIC_VALUE("path_search_latency_p95", percentile(95), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+            TC_METRIC_VALUE("path_search_latency_p99", percentile(99), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+        }
+
+        TC_METRIC_VALUE("path_search_queue_depth", _pathSearches->GetPendingCount(), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+    }
+
     TC_METRIC_VALUE("map_creatures", uint64(GetObjectsStore().Size<Creature>()),
         TC_METRIC_TAG("map_id", std::to_string(GetId())),
         TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
@@ -1012,6 +1199,8 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     bool const inWorld = obj->IsInWorld() && obj->GetTypeId() >= TYPEID_UNIT && obj->GetTypeId() <= TYPEID_GAMEOBJECT;
     obj->RemoveFromWorld();
 
@@ -1192,6 +1381,8 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1202,6 +1393,8 @@ void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float an
 
 void Map::RemoveCreatureFromMoveList(Creature* c)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1211,6 +1404,8 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1221,6 +1416,8 @@ void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, flo
 
 void Map::RemoveGameObjectFromMoveList(GameObject* go)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1230,6 +1427,8 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1240,6 +1439,8 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, fl
 
 void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1720,6 +1921,9 @@ void Map::RemoveAllPlayers()
 
 void Map::UnloadAll()
 {
+    // the navmesh may be freed once the last map using it is unloaded
+    _pathSearches->Wait();
+
     // clear all delayed moves, useless anyway do this moves before map unload.
     _creaturesToMove.clear();
     _gameObjectsToMove.clear();
@@ -1872,7 +2076,11 @@ bool Map::GetAreaInfo(uint32 phaseMask, float x, float y, float z, uint32& flags
     int32 dgroupId;
 
     bool hasVmapAreaInfo = vmgr->getAreaInfo(GetId(), x, y, vmap_z, vflags, vadtId, vrootId, vgroupId);
-    bool hasDynamicAreaInfo = _dynamicTree.getAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    bool hasDynamicAreaInfo;
+    {
+        std::shared_lock<std::shared_mutex> lock = LockDynamicTreeShared();
+        hasDynamicAreaInfo = _dynamicTree.getAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    }
     auto useVmap = [&]() { check_z = vmap_z; flags = vflags; adtId = vadtId; rootId = vrootId; groupId = vgroupId; };
     auto useDyn = [&]() { check_z = dynamic_z; flags = dflags; adtId = dadtId; rootId = drootId; groupId = dgroupId; };
 
@@ -2057,7 +2265,10 @@ void Map::GetFullTerrainStatusForPosition(uint32 phaseMask, float x, float y, fl
     VMAP::AreaAndLiquidData* wmoData = nullptr;
     GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y);
     vmgr->getAreaAndLiquidData(GetId(), x, y, z, AsUnderlyingType(reqLiquidType), vmapData);
-    _dynamicTree.getAreaAndLiquidData(x, y, z, phaseMask, AsUnderlyingType(reqLiquidType), dynData);
+    {
+        std::shared_lock<std::shared_mutex> lock = LockDynamicTreeShared();
+        _dynamicTree.getAreaAndLiquidData(x, y, z, phaseMask, AsUnderlyingType(reqLiquidType), dynData);
+    }
 
     uint32 gridAreaId = 0;
     float gridMapHeight = INVALID_HEIGHT;
@@ -2201,18 +2412,41 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
       && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
         return false;
-    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
-      && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
-        return false;
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+    {
+        std::shared_lock<std::shared_mutex> lock = LockDynamicTreeShared();
+        if (!_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
+            return false;
+    }
     return true;
 }
 
+void Map::RemoveGameObjectModel(GameObjectModel const& model)
+{
+    std::unique_lock<std::shared_mutex> lock = LockDynamicTree();
+    _dynamicTree.remove(model);
+
+    // queries rebalance the tree lazily, they must not write to it under a shared lock while islands are updated
+    if (_updatingIslands)
+        _dynamicTree.balance();
+}
+
+void Map::InsertGameObjectModel(GameObjectModel const& model)
+{
+    std::unique_lock<std::shared_mutex> lock = LockDynamicTree();
+    _dynamicTree.insert(model);
+
+    if (_updatingIslands)
+        _dynamicTree.balance();
+}
+
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos(x1, y1, z1);
     G3D::Vector3 dstPos(x2, y2, z2);
 
     G3D::Vector3 resultPos;
+    std::shared_lock<std::shared_mutex> lock = LockDynamicTreeShared();
     bool result = _dynamicTree.getObjectHitPos(phasemask, startPos, dstPos, resultPos, modifyDist);
 
     rx = resultPos.x;
@@ -2341,6 +2575,31 @@ void Map::SendObjectUpdates()
         obj->BuildUpdate(update_players);
     }
 
+    std::pair<uint32, uint32> blockCacheStats = UpdateBlockCache::ConsumeThreadStats();
+    TC_METRIC_VALUE("update_block_cache_hits", blockCacheStats.first, TC_METRIC_TAG("map_id", std::to_string(GetId())));
+    TC_METRIC_VALUE("update_block_cache_misses", blockCacheStats.second, TC_METRIC_TAG("map_id", std::to_string(GetId())));
+
+    // building and compressing the packets only touches each player's own UpdateData, sending them stays on
+    // this thread so packet send script hooks never run concurrently for the same map
+    uint32 parallelMinPlayers = sWorld->getIntConfig(CONFIG_MAP_UPDATE_PARALLEL_SEND_MIN_PLAYERS);
+    if (parallelMinPlayers && update_players.size() >= parallelMinPlayers && sMapMgr->GetMapUpdater()->activated())
+    {
+        std::vector<UpdateDataMapType::value_type*> updates;
+        updates.reserve(update_players.size());
+        for (UpdateDataMapType::value_type& update : update_players)
+            updates.push_back(&update);
+
+        std::vector<WorldPacket> packets(updates.size());
+        sMapMgr->GetMapUpdater()->run_parallel(updates.size(), [&updates, &packets](std::size_t i)
+        {
+            updates[i]->second.BuildPacket(&packets[i]);
+        });
+
+        for (std::size_t i = 0; i < updates.size(); ++i)
+            updates[i]->first->SendDirectMessage(&packets[i]);
+        return;
+    }
+
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
@@ -2435,6 +2694,7 @@ void Map::Respawn(RespawnInfo* info, CharacterDatabaseTransaction dbTrans)
 size_t Map::DespawnAll(SpawnObjectType type, ObjectGuid::LowType spawnId)
 {
     std::vector<WorldObject*> toUnload;
+    std::shared_lock<std::shared_mutex> storeLock = LockObjectsStoreShared();
     switch (type)
     {
         case SPAWN_TYPE_CREATURE:
@@ -2448,6 +2708,7 @@ size_t Map::DespawnAll(SpawnObjectType type, ObjectGuid::LowType spawnId)
         default:
             break;
     }
+    storeLock = { };
 
     for (WorldObject* o : toUnload)
         AddObjectToRemoveList(o);
@@ -2702,6 +2963,8 @@ SpawnGroupTemplateData const* Map::GetSpawnGroupData(uint32 groupId) const
 
 bool Map::SpawnGroupSpawn(uint32 groupId, bool ignoreRespawn, bool force, std::vector<WorldObject*>* spawnedObjects)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     SpawnGroupTemplateData const* groupData = GetSpawnGroupData(groupId);
     if (!groupData || groupData->flags & SPAWNGROUP_FLAG_SYSTEM)
     {
@@ -2778,6 +3041,8 @@ bool Map::SpawnGroupSpawn(uint32 groupId, bool ignoreRespawn, bool force, std::v
 
 bool Map::SpawnGroupDespawn(uint32 groupId, bool deleteRespawnTimes, size_t* count)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     SpawnGroupTemplateData const* groupData = GetSpawnGroupData(groupId);
     if (!groupData || groupData->flags & SPAWNGROUP_FLAG_SYSTEM)
     {
@@ -2882,6 +3147,8 @@ void Map::DelayedUpdate(uint32 t_diff)
 
 void Map::AddObjectToRemoveList(WorldObject* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
@@ -2891,6 +3158,8 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
 void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
     // i_objectsToSwitch is iterated only in Map::RemoveAllObjectsInRemoveList() and it uses
     // the contained objects only if GetTypeId() == TYPEID_UNIT , so we can return in all other cases
@@ -3052,6 +3321,8 @@ bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     AddToActiveHelper(obj);
 
     Optional<Position> respawnLocation;
@@ -3091,6 +3362,8 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     RemoveFromActiveHelper(obj);
 
     Optional<Position> respawnLocation;
@@ -3712,16 +3985,19 @@ Player* Map::GetPlayer(ObjectGuid const& guid)
 
 Corpse* Map::GetCorpse(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_mutex> lock = LockObjectsStoreShared();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_mutex> lock = LockObjectsStoreShared();
     return _objectsStore.Find<Creature>(guid);
 }
 
 Creature* Map::GetCreatureBySpawnId(ObjectGuid::LowType spawnId) const
 {
+    std::shared_lock<std::shared_mutex> lock = LockObjectsStoreShared();
     auto const bounds = GetCreatureBySpawnIdStore().equal_range(spawnId);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -3736,6 +4012,7 @@ Creature* Map::GetCreatureBySpawnId(ObjectGuid::LowType spawnId) const
 
 GameObject* Map::GetGameObjectBySpawnId(ObjectGuid::LowType spawnId) const
 {
+    std::shared_lock<std::shared_mutex> lock = LockObjectsStoreShared();
     auto const bounds = GetGameObjectBySpawnIdStore().equal_range(spawnId);
     if (bounds.first == bounds.second)
         return nullptr;
@@ -3750,11 +4027,13 @@ GameObject* Map::GetGameObjectBySpawnId(ObjectGuid::LowType spawnId) const
 
 GameObject* Map::GetGameObject(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_mutex> lock = LockObjectsStoreShared();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_mutex> lock = LockObjectsStoreShared();
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -3769,6 +4048,7 @@ Transport* Map::GetTransport(ObjectGuid const& guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid const& guid)
 {
+    std::shared_lock<std::shared_mutex> lock = LockObjectsStoreShared();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -3780,6 +4060,8 @@ void Map::UpdateIteratorBack(Player* player)
 
 void Map::SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 entry, time_t respawnTime, uint32 gridId, CharacterDatabaseTransaction dbTrans, bool startup)
 {
+    std::unique_lock<std::recursive_mutex> lock = LockIslands();
+
     SpawnMetadata const* data = sObjectMgr->GetSpawnMetadata(type, spawnId);
     if (!data)
     {
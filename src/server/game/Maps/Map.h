@@ -39,6 +39,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 class Battleground;
 class BattlegroundMap;
@@ -49,6 +50,9 @@ class InstanceMap;
 class InstanceSave;
 class InstanceScript;
 class MapInstanced;
+class MapIslandPartition;
+class PathCache;
+class PathSearchQueue;
 class Object;
 class Player;
 class TempSummon;
@@ -169,6 +173,41 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(uint32 diff);
 
+        /// Whether the objects of independent cell islands are being updated on several threads right now, see UpdateIslands
+        bool IsUpdatingIslands() const { return _updatingIslands; }
+
+        /// Serializes changes to map wide state (object lists, respawn times, guid generators, scripts...) while islands
+        /// are updated in parallel, the returned lock owns nothing at any other time
+        std::unique_lock<std::recursive_mutex> LockIslands() const
+        {
+            if (!_updatingIslands)
+                return { };
+
+            return std::unique_lock<std::recursive_mutex>(_islandLock);
+        }
+
+        /// Guards lookups in the object stores against islands adding or removing objects at the same time
+        std::shared_lock<std::shared_mutex> LockObjectsStoreShared() const
+        {
+            if (!_updatingIslands)
+                return { };
+
+            return std::shared_lock<std::shared_mutex>(_objectsStoreLock);
+        }
+
+        /// Must be held while objects are added to or removed from the object stores
+        std::unique_lock<std::shared_mutex> LockObjectsStore() const
+        {
+            if (!_updatingIslands)
+                return { };
+
+            return std::unique_lock<std::shared_mutex>(_objectsStoreLock);
+        }
+
+        // exponentially smoothed duration of previous updates, used by MapUpdater to start the most expensive maps first
+        Microseconds GetUpdateCostEstimate() const { return _updateCostEstimate; }
+        void AddUpdateCostSample(Microseconds updateTime) { _updateCostEstimate = (_updateCostEstimate * 3 + updateTime) / 4; }
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -401,15 +440,26 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         BattlegroundMap const* ToBattlegroundMap() const { if (IsBattlegroundOrArena()) return reinterpret_cast<BattlegroundMap const*>(this); return nullptr; }
 
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
-        void Balance() { _dynamicTree.balance(); }
-        void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); }
-        void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); }
-        bool ContainsGameObjectModel(GameObjectModel const& model) const { return _dynamicTree.contains(model);}
+        void Balance()
+        {
+            std::unique_lock<std::shared_mutex> lock = LockDynamicTree();
+            _dynamicTree.balance();
+        }
+        void RemoveGameObjectModel(GameObjectModel const& model);
+        void InsertGameObjectModel(GameObjectModel const& model);
+        bool ContainsGameObjectModel(GameObjectModel const& model) const
+        {
+            std::shared_lock<std::shared_mutex> lock = LockDynamicTreeShared();
+            return _dynamicTree.contains(model);
+        }
         float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
         {
+            std::shared_lock<std::shared_mutex> lock = LockDynamicTreeShared();
             return _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
         }
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
+        PathCache* GetPathCache() const { return _pathCache.get(); }
+        PathSearchQueue* GetPathSearchQueue() const { return _pathSearches.get(); }
 
         /*
             RESPAWN TIMES
@@ -417,6 +467,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         time_t GetLinkedRespawnTime(ObjectGuid guid) const;
         time_t GetRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId) const
         {
+            std::unique_lock<std::recursive_mutex> lock = LockIslands();
             auto const& map = GetRespawnMapForType(type);
             auto it = map.find(spawnId);
             return (it == map.end()) ? 0 : it->second->respawnTime;
@@ -457,6 +508,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         inline ObjectGuid::LowType GenerateLowGuid()
         {
             static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+            std::unique_lock<std::recursive_mutex> lock = LockIslands();
             return GetGuidSequenceGenerator(high).Generate();
         }
 
@@ -469,11 +521,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
+            std::unique_lock<std::recursive_mutex> lock = LockIslands();
             _updateObjects.insert(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
+            std::unique_lock<std::recursive_mutex> lock = LockIslands();
             _updateObjects.erase(obj);
         }
 
@@ -489,6 +543,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void LoadMap(int32 gx, int32 gy);
         void LoadVMap(int32 gx, int32 gy);
         void LoadMMap(int32 gx, int32 gy);
+        void PrefetchAdjacentMMaps(int32 gx, int32 gy);
 
         void UnloadMap(int32 gx, int32 gy);
         GridMap* GetGrid(float x, float y);
@@ -540,6 +595,26 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void SendObjectUpdates();
 
+        void GetFarUpdateSourcesOf(Player* player, std::vector<WorldObject*>& sources);
+        bool CanUpdateIslands() const;
+        void UpdateIslands(uint32 diff);
+
+        std::shared_lock<std::shared_mutex> LockDynamicTreeShared() const
+        {
+            if (!_updatingIslands)
+                return { };
+
+            return std::shared_lock<std::shared_mutex>(_dynamicTreeLock);
+        }
+
+        std::unique_lock<std::shared_mutex> LockDynamicTree() const
+        {
+            if (!_updatingIslands)
+                return { };
+
+            return std::unique_lock<std::shared_mutex>(_dynamicTreeLock);
+        }
+
     protected:
         virtual void LoadGridObjects(NGridType* grid, Cell const& cell);
 
@@ -553,6 +628,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        std::unique_ptr<PathCache> _pathCache;
+        std::unique_ptr<PathSearchQueue> _pathSearches;
+
+        bool _updatingIslands;
+        mutable std::recursive_mutex _islandLock;
+        mutable std::shared_mutex _objectsStoreLock;
+        mutable std::shared_mutex _dynamicTreeLock;
+        std::unique_ptr<MapIslandPartition> _islands;
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -626,11 +709,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void GetRespawnInfo(std::vector<RespawnInfo const*>& respawnData, SpawnObjectTypeMask types) const;
         void Respawn(SpawnObjectType type, ObjectGuid::LowType spawnId, CharacterDatabaseTransaction dbTrans = nullptr)
         {
+            std::unique_lock<std::recursive_mutex> lock = LockIslands();
             if (RespawnInfo* info = GetRespawnInfo(type, spawnId))
                 Respawn(info, dbTrans);
         }
         void RemoveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, CharacterDatabaseTransaction dbTrans = nullptr, bool alwaysDeleteFromDB = false)
         {
+            std::unique_lock<std::recursive_mutex> lock = LockIslands();
             if (RespawnInfo* info = GetRespawnInfo(type, spawnId))
                 DeleteRespawnInfo(info, dbTrans);
             // Some callers might need to make sure the database doesn't contain any respawn time
@@ -721,6 +806,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_set<uint32> _toggledSpawnGroupIds;
 
         uint32 _respawnCheckTimer;
+        Microseconds _updateCostEstimate;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
@@ -50,12 +50,23 @@ void MapInstanced::Update(uint32 t)
     // take care of loaded GridMaps (when unused, unload it!)
     Map::Update(t);
 
+    // with map update threads MapManager calls this on its own thread and schedules the instances together with all other maps
+    if (sMapMgr->GetMapUpdater()->activated())
+        return;
+
     // update the instanced maps
-    InstancedMaps::iterator i = m_InstancedMaps.begin();
+    std::vector<Map*> instances;
+    CollectInstancesToUpdate(t, instances);
+    for (Map* instance : instances)
+        instance->Update(t);
+}
 
+void MapInstanced::CollectInstancesToUpdate(uint32 diff, std::vector<Map*>& maps)
+{
+    InstancedMaps::iterator i = m_InstancedMaps.begin();
     while (i != m_InstancedMaps.end())
     {
-        if (i->second->CanUnload(t))
+        if (i->second->CanUnload(diff))
         {
             if (!DestroyInstance(i))                             // iterator incremented
             {
@@ -64,11 +75,7 @@ void MapInstanced::Update(uint32 t)
         }
         else
         {
-            // update only here, because it may schedule some bad things before delete
-            if (sMapMgr->GetMapUpdater()->activated())
-                sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
-            else
-                i->second->Update(t);
+            maps.push_back(i->second.get());
             ++i;
         }
     }
@@ -35,6 +35,8 @@ class TC_GAME_API MapInstanced : public Map
         // functions overwrite Map versions
         void Update(uint32 diff) override;
         void DelayedUpdate(uint32 diff) override;
+        // unloads the instances that can be unloaded and adds the others to maps, for updates scheduled on the map update threads
+        void CollectInstancesToUpdate(uint32 diff, std::vector<Map*>& maps);
         //void RelocationNotify();
         void UnloadAll() override;
         EnterState CannotEnter(Player* /*player*/) override;
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapIslands.h"
+#include <algorithm>
+
+uint32 MapIslandPartition::AddSource(CellArea const& area, Optional<uint32> linkedTo /*= {}*/)
+{
+    uint32 source = uint32(_areas.size());
+    _areas.push_back(area);
+    _parents.push_back(source);
+
+    if (linkedTo)
+        Join(*linkedTo, source);
+
+    return source;
+}
+
+uint32 MapIslandPartition::Build()
+{
+    uint32 blockSize = std::max(_haloCells, 1u);
+    uint32 blocksPerSide = (TOTAL_NUMBER_OF_CELLS_PER_MAP + blockSize - 1) / blockSize;
+    if (_blocksPerSide != blocksPerSide)
+    {
+        _blocksPerSide = blocksPerSide;
+        _blockOwners.assign(blocksPerSide * blocksPerSide, NoIsland);
+    }
+
+    for (uint32 source = 0; source < _areas.size(); ++source)
+    {
+        CellArea const& area = _areas[source];
+        uint32 lowX = (area.low_bound.x_coord - std::min(area.low_bound.x_coord, _haloCells)) / blockSize;
+        uint32 lowY = (area.low_bound.y_coord - std::min(area.low_bound.y_coord, _haloCells)) / blockSize;
+        uint32 highX = std::min(area.high_bound.x_coord + _haloCells, uint32(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1)) / blockSize;
+        uint32 highY = std::min(area.high_bound.y_coord + _haloCells, uint32(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1)) / blockSize;
+
+        for (uint32 y = lowY; y <= highY; ++y)
+        {
+            for (uint32 x = lowX; x <= highX; ++x)
+            {
+                uint32& owner = _blockOwners[y * blocksPerSide + x];
+                if (owner == NoIsland)
+                {
+                    owner = source;
+                    _ownedBlocks.push_back(y * blocksPerSide + x);
+                }
+                else
+                    Join(owner, source);
+            }
+        }
+    }
+
+    for (uint32 block : _ownedBlocks)
+        _blockOwners[block] = NoIsland;
+    _ownedBlocks.clear();
+
+    // the root of an island is its lowest source, so islands are numbered by their first source
+    std::vector<uint32> rootIslands(_areas.size(), NoIsland);
+    uint32 islandCount = 0;
+    _islands.resize(_areas.size());
+    for (uint32 source = 0; source < _areas.size(); ++source)
+    {
+        uint32& island = rootIslands[FindRoot(source)];
+        if (island == NoIsland)
+            island = islandCount++;
+
+        _islands[source] = island;
+    }
+
+    return islandCount;
+}
+
+void MapIslandPartition::Clear()
+{
+    _areas.clear();
+    _parents.clear();
+    _islands.clear();
+}
+
+uint32 MapIslandPartition::FindRoot(uint32 source)
+{
+    while (_parents[source] != source)
+    {
+        _parents[source] = _parents[_parents[source]];
+        source = _parents[source];
+    }
+
+    return source;
+}
+
+void MapIslandPartition::Join(uint32 left, uint32 right)
+{
+    left = FindRoot(left);
+    right = FindRoot(right);
+    if (left == right)
+        return;
+
+    // the lower source stays root so that islands keep the order of their first source
+    if (left < right)
+        _parents[right] = left;
+    else
+        _parents[left] = right;
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAP_ISLANDS_H
+#define TRINITY_MAP_ISLANDS_H
+
+#include "Cell.h"
+#include "Optional.h"
+#include <limits>
+#include <vector>
+
+/// Splits the cells activated by the update sources of a map (players, their far sight targets, active objects...)
+/// into islands that can be updated at the same time.
+/// Halo ownership rule: an island owns the cells activated by its sources plus a halo of haloCells cells around
+/// them, sources whose owned cells overlap are put into the same island. The cells owned by different islands
+/// never overlap, an object acting within one halo of the cell it is updated in only ever reaches its own island.
+/// Overlaps are found on blocks of haloCells x haloCells cells, which may join sources up to one block further
+/// apart than needed but keeps Build cheap enough to run on every map update.
+class TC_GAME_API MapIslandPartition
+{
+public:
+    static constexpr uint32 NoIsland = std::numeric_limits<uint32>::max();
+
+    explicit MapIslandPartition(uint32 haloCells) : _haloCells(haloCells), _blocksPerSide(0) { }
+
+    MapIslandPartition(MapIslandPartition const&) = delete;
+    MapIslandPartition& operator=(MapIslandPartition const&) = delete;
+
+    /// Adds a source activating the cells of area and returns its index.
+    /// A source linked to an earlier one is always put into the island of that source, no matter how far apart they are.
+    uint32 AddSource(CellArea const& area, Optional<uint32> linkedTo = {});
+
+    /// Puts two sources added earlier into the same island, no matter how far apart they are.
+    void Link(uint32 left, uint32 right) { Join(left, right); }
+
+    /// Assigns every source to an island, islands are numbered in the order of their first source.
+    /// Returns the number of islands.
+    uint32 Build();
+
+    std::size_t GetSourceCount() const { return _areas.size(); }
+    CellArea const& GetArea(uint32 source) const { return _areas[source]; }
+    uint32 GetIsland(uint32 source) const { return _islands[source]; }
+
+    void SetHaloCells(uint32 haloCells) { _haloCells = haloCells; }
+
+    /// Removes all sources, the memory is kept for the next partition
+    void Clear();
+
+private:
+    uint32 FindRoot(uint32 source);
+    void Join(uint32 left, uint32 right);
+
+    uint32 _haloCells;
+    std::vector<CellArea> _areas;
+    std::vector<uint32> _parents;                   // union-find forest of the sources
+    std::vector<uint32> _islands;
+    uint32 _blocksPerSide;
+    std::vector<uint32> _blockOwners;               // first source owning each block of the map, only used during Build
+    std::vector<uint32> _ownedBlocks;               // blocks set in _blockOwners, reset at the end of Build
+};
+
+#endif // TRINITY_MAP_ISLANDS_H
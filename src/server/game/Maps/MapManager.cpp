@@ -28,6 +28,7 @@
 #include "World.h"
 #include "Corpse.h"
 #include "ObjectMgr.h"
+#include "PathSearchQueue.h"
 #include "WorldPacket.h"
 #include "Group.h"
 #include "Player.h"
@@ -54,6 +55,8 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    PathSearchQueue::StartWorkers(sWorld->getIntConfig(CONFIG_PATH_SEARCH_THREADS));
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -242,15 +245,32 @@ void MapManager::Update(uint32 diff)
         return;
 
     MapMapType::iterator iter = i_maps.begin();
-    for (; iter != i_maps.end(); ++iter)
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
-        else
+        // instances are sorted in with every other map, a busy raid must not wait for all continents to be queued
+        std::vector<Map*> maps;
+        maps.reserve(i_maps.size());
+        for (; iter != i_maps.end(); ++iter)
+        {
+            // the base map of instanced maps holds no players and is cheap to update, it is updated here
+            // so it never runs at the same time as its instances
+            if (MapInstanced* instanced = iter->second->ToMapInstanced())
+            {
+                instanced->Update(uint32(i_timer.GetCurrent()));
+                instanced->CollectInstancesToUpdate(uint32(i_timer.GetCurrent()), maps);
+            }
+            else
+                maps.push_back(iter->second.get());
+        }
+
+        m_updater.schedule_updates(maps, uint32(i_timer.GetCurrent()));
+        m_updater.wait();
+    }
+    else
+    {
+        for (; iter != i_maps.end(); ++iter)
             iter->second->Update(uint32(i_timer.GetCurrent()));
     }
-    if (m_updater.activated())
-        m_updater.wait();
 
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
@@ -296,6 +316,8 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    PathSearchQueue::StopWorkers();
+
     Map::DeleteStateMachine();
 }
 
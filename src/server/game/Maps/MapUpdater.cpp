@@ -20,31 +20,80 @@
 #include "Map.h"
 #include "Metric.h"
 
+#include <algorithm>
+#include <memory>
 #include <mutex>
 
-class MapUpdateRequest
+class MapUpdateRequest : public UpdateRequest
 {
     private:
 
         Map& m_map;
         MapUpdater& m_updater;
         uint32 m_diff;
+        TimePoint m_scheduleTime;
 
     public:
 
         MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+            : m_map(m), m_updater(u), m_diff(d), m_scheduleTime(std::chrono::steady_clock::now())
         {
         }
 
-        void call()
+        void call() override
         {
-            TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
-            m_map.Update (m_diff);
+            TimePoint startTime = std::chrono::steady_clock::now();
+            TC_METRIC_VALUE("map_update_queue_wait", startTime - m_scheduleTime, TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+
+            {
+                TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+                m_map.Update (m_diff);
+            }
+
+            m_map.AddUpdateCostSample(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - startTime));
             m_updater.update_finished();
         }
 };
 
+struct ParallelWork
+{
+    ParallelWork(std::size_t count, std::function<void(std::size_t)> const& func) : Count(count), Func(func), Next(0), Active(0) { }
+
+    // claims items until none are left, Func must not be touched once Next passed Count
+    void Process()
+    {
+        for (std::size_t i = Next++; i < Count; i = Next++)
+            Func(i);
+    }
+
+    std::size_t const Count;
+    std::function<void(std::size_t)> const& Func;
+    std::atomic<std::size_t> Next;
+    std::atomic<std::size_t> Active;
+    std::mutex Lock;
+    std::condition_variable Finished;
+};
+
+class ParallelWorkRequest : public UpdateRequest
+{
+    public:
+        explicit ParallelWorkRequest(std::shared_ptr<ParallelWork> work) : _work(std::move(work)) { }
+
+        void call() override
+        {
+            // register before claiming work so that the caller waits for us if we get any
+            ++_work->Active;
+            _work->Process();
+
+            std::lock_guard<std::mutex> lock(_work->Lock);
+            if (!--_work->Active)
+                _work->Finished.notify_all();
+        }
+
+    private:
+        std::shared_ptr<ParallelWork> _work;
+};
+
 void MapUpdater::activate(size_t num_threads)
 {
     for (size_t i = 0; i < num_threads; ++i)
@@ -86,6 +135,39 @@ void MapUpdater::schedule_update(Map& map, uint32 diff)
     _queue.Push(new MapUpdateRequest(map, *this, diff));
 }
 
+void MapUpdater::schedule_updates(std::vector<Map*>& maps, uint32 diff)
+{
+    std::stable_sort(maps.begin(), maps.end(), [](Map const* left, Map const* right)
+    {
+        return left->GetUpdateCostEstimate() > right->GetUpdateCostEstimate();
+    });
+
+    for (Map* map : maps)
+        schedule_update(*map, diff);
+}
+
+void MapUpdater::run_parallel(std::size_t count, std::function<void(std::size_t)> const& func)
+{
+    std::size_t helpers = count > 1 ? std::min(_workerThreads.size(), count - 1) : 0;
+    if (!helpers)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            func(i);
+        return;
+    }
+
+    std::shared_ptr<ParallelWork> work = std::make_shared<ParallelWork>(count, func);
+    for (std::size_t i = 0; i < helpers; ++i)
+        _queue.Push(new ParallelWorkRequest(work));
+
+    work->Process();
+
+    // helpers still queued behind other requests will find nothing left to do
+    std::unique_lock<std::mutex> lock(work->Lock);
+    while (work->Active)
+        work->Finished.wait(lock);
+}
+
 bool MapUpdater::activated()
 {
     return _workerThreads.size() > 0;
@@ -108,7 +190,7 @@ void MapUpdater::WorkerThread()
 
     while (true)
     {
-        MapUpdateRequest* request = nullptr;
+        UpdateRequest* request = nullptr;
 
         _queue.WaitAndPop(request);
 
@@ -19,14 +19,24 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <functional>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include <condition_variable>
 #include "ProducerConsumerQueue.h"
 
 class MapUpdateRequest;
 class Map;
 
+class UpdateRequest
+{
+    public:
+        virtual ~UpdateRequest() = default;
+
+        virtual void call() = 0;
+};
+
 class TC_GAME_API MapUpdater
 {
     public:
@@ -38,6 +48,13 @@ class TC_GAME_API MapUpdater
 
         void schedule_update(Map& map, uint32 diff);
 
+        /// Schedules all maps, most expensive first so that a large map does not start last and stretch the tick
+        void schedule_updates(std::vector<Map*>& maps, uint32 diff);
+
+        /// Calls func(0) .. func(count - 1) on the calling thread, helped by worker threads that are idle.
+        /// Can be used from inside a map update, it never waits for a worker that has not started helping.
+        void run_parallel(std::size_t count, std::function<void(std::size_t)> const& func);
+
         void wait();
 
         void activate(size_t num_threads);
@@ -48,7 +65,7 @@ class TC_GAME_API MapUpdater
 
     private:
 
-        ProducerConsumerQueue<MapUpdateRequest*> _queue;
+        ProducerConsumerQueue<UpdateRequest*> _queue;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
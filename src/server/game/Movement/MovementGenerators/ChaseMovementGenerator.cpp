@@ -172,7 +172,10 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
 
             // make a new path if we have to...
             if (!_path || moveToward != _movingTowards)
+            {
                 _path = std::make_unique<PathGenerator>(owner);
+                _path->SetUseAsync(true);
+            }
 
             float x, y, z;
             bool shortenPath;
@@ -194,6 +197,13 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
                 owner->UpdateAllowedPositionZ(x, y, z);
 
             bool success = _path->CalculatePath(x, y, z, owner->CanFly());
+            if (_path->GetPathType() & PATHFIND_PENDING)
+            {
+                // path is still being searched, try again next update
+                _lastTargetPosition.reset();
+                return true;
+            }
+
             if (!success || (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
             {
                 if (cOwner)
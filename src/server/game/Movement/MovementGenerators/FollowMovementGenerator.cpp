@@ -118,7 +118,10 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
         if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE) || !PositionOkay(owner, target, _range + FOLLOW_RANGE_TOLERANCE))
         {
             if (!_path)
+            {
                 _path = std::make_unique<PathGenerator>(owner);
+                _path->SetUseAsync(true);
+            }
 
             float x, y, z;
 
@@ -151,6 +154,13 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
             }
 
             bool success = _path->CalculatePath(x, y, z, allowShortcut);
+            if (_path->GetPathType() & PATHFIND_PENDING)
+            {
+                // path is still being searched, try again next update
+                _lastTargetPosition.reset();
+                return true;
+            }
+
             if (!success || (_path->GetPathType() & PATHFIND_NOPATH))
             {
                 owner->StopMoving();
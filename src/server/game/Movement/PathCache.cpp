@@ -0,0 +1,115 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include "DetourNavMeshQuery.h"
+#include "Hash.h"
+#include <algorithm>
+#include <utility>
+
+// older corridors towards the same end poly are dropped past this count
+constexpr std::size_t MAX_CORRIDORS_PER_END_POLY = 8;
+
+std::size_t PathCache::KeyHash::operator()(Key const& key) const
+{
+    std::size_t hashVal = 0;
+    Trinity::hash_combine(hashVal, key.EndPoly);
+    Trinity::hash_combine(hashVal, key.IncludeFlags);
+    Trinity::hash_combine(hashVal, key.ExcludeFlags);
+    return hashVal;
+}
+
+PathCache::Key PathCache::MakeKey(dtPolyRef endPoly, dtQueryFilter const& filter)
+{
+    return { endPoly, filter.getIncludeFlags(), filter.getExcludeFlags() };
+}
+
+bool PathCache::Find(dtNavMesh const* navMesh, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter,
+    dtPolyRef* path, uint32* pathSize, uint32 maxPathSize)
+{
+    auto itr = _corridors.find(MakeKey(endPoly, filter));
+    if (itr != _corridors.end())
+    {
+        std::vector<Corridor>& corridors = itr->second;
+        for (auto corridor = corridors.rbegin(); corridor != corridors.rend(); ++corridor)
+        {
+            auto start = std::find(corridor->Polys.begin(), corridor->Polys.end(), startPoly);
+            if (start == corridor->Polys.end() || uint32(corridor->Polys.end() - start) > maxPathSize)
+                continue;
+
+            // the tiles may have been unloaded since, refs to their polys are stale then
+            if (!std::all_of(start, corridor->Polys.end(), [navMesh](dtPolyRef poly) { return navMesh->isValidPolyRef(poly); }))
+            {
+                corridors.erase(std::next(corridor).base());
+                break;
+            }
+
+            *pathSize = uint32(std::copy(start, corridor->Polys.end(), path) - path);
+            ++_hits;
+            // a search from further along the corridor visits fewer polys, count the share of the suffix only
+            _timeSaved += uint64(corridor->QueryTime) * *pathSize / corridor->Polys.size();
+            return true;
+        }
+    }
+
+    ++_misses;
+    return false;
+}
+
+void PathCache::Store(dtPolyRef endPoly, dtQueryFilter const& filter, dtStatus status, dtPolyRef const* path, uint32 pathSize, uint32 queryTime, uint32 now)
+{
+    // a corridor cut short by the search or its buffer would be handed out as the whole path to endPoly
+    if (dtStatusFailed(status) || dtStatusDetail(status, DT_PARTIAL_RESULT) || dtStatusDetail(status, DT_BUFFER_TOO_SMALL))
+        return;
+
+    if (!pathSize || path[pathSize - 1] != endPoly)
+        return;
+
+    std::vector<Corridor>& corridors = _corridors[MakeKey(endPoly, filter)];
+    if (corridors.size() >= MAX_CORRIDORS_PER_END_POLY)
+        corridors.erase(corridors.begin());
+
+    Corridor& corridor = corridors.emplace_back();
+    corridor.Polys.assign(path, path + pathSize);
+    corridor.QueryTime = queryTime;
+    corridor.StoreTime = now;
+}
+
+void PathCache::Update(uint32 now, uint32 duration)
+{
+    for (auto itr = _corridors.begin(); itr != _corridors.end();)
+    {
+        // corridors are stored oldest first
+        std::vector<Corridor>& corridors = itr->second;
+        corridors.erase(corridors.begin(), std::find_if(corridors.begin(), corridors.end(), [&](Corridor const& corridor)
+        {
+            return now - corridor.StoreTime <= duration;
+        }));
+
+        if (corridors.empty())
+            itr = _corridors.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+void PathCache::ConsumeStats(uint32& hits, uint32& misses, uint64& timeSaved)
+{
+    hits = std::exchange(_hits, 0);
+    misses = std::exchange(_misses, 0);
+    timeSaved = std::exchange(_timeSaved, 0);
+}
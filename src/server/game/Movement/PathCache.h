@@ -0,0 +1,88 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PATH_CACHE_H
+#define TRINITY_PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <unordered_map>
+#include <vector>
+
+class dtQueryFilter;
+
+/// Per map store of the poly corridors recently found by PathGenerator.
+/// Creatures chasing the same target all search towards the same end poly, a corridor found for one of them
+/// also holds the path of every other one standing on a poly of that corridor: its suffix from that poly
+/// (a sub path of a shortest path is a shortest path). Corridors are kept for a short time only.
+class TC_GAME_API PathCache
+{
+public:
+    PathCache() : _hits(0), _misses(0), _timeSaved(0) { }
+
+    PathCache(PathCache const&) = delete;
+    PathCache& operator=(PathCache const&) = delete;
+
+    /// Copies the part of a cached corridor to endPoly that starts at startPoly into path.
+    /// Returns false when no cached corridor passes startPoly or its suffix is longer than maxPathSize.
+    bool Find(dtNavMesh const* navMesh, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter,
+        dtPolyRef* path, uint32* pathSize, uint32 maxPathSize);
+
+    /// Stores a corridor found by dtNavMeshQuery::findPath with the given status, queryTime is how long (in microseconds) the search took.
+    /// Partial or truncated corridors that do not reach endPoly are not stored.
+    void Store(dtPolyRef endPoly, dtQueryFilter const& filter, dtStatus status, dtPolyRef const* path, uint32 pathSize, uint32 queryTime, uint32 now);
+
+    /// Drops the corridors stored more than duration ms before now.
+    void Update(uint32 now, uint32 duration);
+
+    void Clear() { _corridors.clear(); }
+
+    /// Returns and resets the number of hits, misses and the search time (in microseconds) saved by hits since the last call.
+    /// The time saved by a hit is estimated as the search time of its corridor scaled by the share of the corridor it used.
+    void ConsumeStats(uint32& hits, uint32& misses, uint64& timeSaved);
+
+private:
+    struct Corridor
+    {
+        std::vector<dtPolyRef> Polys;
+        uint32 QueryTime;
+        uint32 StoreTime;
+    };
+
+    struct Key
+    {
+        dtPolyRef EndPoly;
+        uint16 IncludeFlags;
+        uint16 ExcludeFlags;
+
+        bool operator==(Key const& right) const = default;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    static Key MakeKey(dtPolyRef endPoly, dtQueryFilter const& filter);
+
+    std::unordered_map<Key, std::vector<Corridor>, KeyHash> _corridors;
+    uint32 _hits;
+    uint32 _misses;
+    uint64 _timeSaved;
+};
+
+#endif // TRINITY_PATH_CACHE_H
@@ -25,11 +25,16 @@
 #include "DetourCommon.h"
 #include "DetourNavMeshQuery.h"
 #include "Metric.h"
+#include "GameTime.h"
+#include "PathCache.h"
+#include "PathSearchQueue.h"
+#include "World.h"
+#include <chrono>
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
-    _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
+    _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false), _useAsync(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
     _navMeshQuery(nullptr)
 {
@@ -63,6 +68,9 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     TC_METRIC_DETAILED_EVENT("mmap_events", "CalculatePath", "");
 
+    // the navmesh query and the path cache are shared by the whole map
+    std::unique_lock<std::recursive_mutex> islandLock = _source->GetMap()->LockIslands();
+
     G3D::Vector3 dest(destX, destY, destZ);
     SetEndPosition(dest);
 
@@ -287,6 +295,23 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         return;
     }
 
+    // a search queued by an earlier call has to finish first, its corridor then replaces the current path
+    // and gets reused (or its suffix repaired) like any previous path below
+    bool searchedAsync = false;
+    if (_pendingSearch)
+    {
+        if (!_pendingSearch->IsDone())
+        {
+            Clear();
+            _type = PATHFIND_PENDING;
+            return;
+        }
+
+        TakeSearchResult(*_pendingSearch);
+        _pendingSearch = nullptr;
+        searchedAsync = true;
+    }
+
     // look for startPoly/endPoly in current path
     /// @todo we can merge it with getPathPolyByPosition() loop
     bool startPolyFound = false;
@@ -386,15 +411,15 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             suffixStartPoly,    // start polygon
                             endPoly,            // end polygon
                             suffixEndPoint,     // start position
                             endPoint,           // end position
-                            &_filter,            // polygon search filter
                             _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                            (int*)&suffixPolyLength,
-                            MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
+                            &suffixPolyLength,
+                            MAX_PATH_LENGTH - prefixPolyLength,    // max number of polygons in output path
+                            false);             // the suffix is short, not worth a wait
         }
 
         if (!suffixPolyLength || dtStatusFailed(dtResult))
@@ -493,15 +518,21 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             startPoly,          // start polygon
                             endPoly,            // end polygon
                             startPoint,         // start position
                             endPoint,           // end position
-                            &_filter,           // polygon search filter
                             _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
-                            MAX_PATH_LENGTH);   // max number of polygons in output path
+                            &_polyLength,
+                            MAX_PATH_LENGTH,    // max number of polygons in output path
+                            _useAsync && !searchedAsync);   // search synchronously if the queued one did not help
+
+            if (dtStatusInProgress(dtResult))
+            {
+                _type = PATHFIND_PENDING;
+                return;
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -526,6 +557,67 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathGenerator::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+    dtPolyRef* path, uint32* pathSize, uint32 maxPathSize, bool allowAsync)
+{
+    uint32 cacheDuration = sWorld->getIntConfig(CONFIG_MMAP_PATH_CACHE_DURATION);
+    PathCache* cache = cacheDuration ? _source->GetMap()->GetPathCache() : nullptr;
+    if (cache && cache->Find(_navMesh, startPoly, endPoly, _filter, path, pathSize, maxPathSize))
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::FindPolyPath :: reused cached corridor of {} polys", *pathSize);
+        return DT_SUCCESS;
+    }
+
+    std::shared_ptr<MMAP::NavMeshLock> navMeshLock = allowAsync ? MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshLock(_source->GetMapId()) : nullptr;
+    if (navMeshLock && maxPathSize == MAX_PATH_LENGTH)
+    {
+        std::shared_ptr<PathSearch> search = std::make_shared<PathSearch>();
+        search->NavMesh = _navMesh;
+        search->NavMeshLock = std::move(navMeshLock);
+        search->Filter = _filter;
+        search->StartPoly = startPoly;
+        search->EndPoly = endPoly;
+        dtVcopy(search->StartPoint, startPoint);
+        dtVcopy(search->EndPoint, endPoint);
+        if (_source->GetMap()->GetPathSearchQueue()->Submit(search))
+        {
+            _pendingSearch = std::move(search);
+            *pathSize = 0;
+            return DT_IN_PROGRESS;
+        }
+    }
+
+    auto queryStart = std::chrono::steady_clock::now();
+
+    int polyCount = 0;
+    dtStatus dtResult = _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter, path, &polyCount, maxPathSize);
+    *pathSize = uint32(polyCount);
+
+    if (cache)
+        cache->Store(endPoly, _filter, dtResult, path, *pathSize,
+            uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queryStart).count()),
+            GameTime::GetGameTimeMS());
+
+    return dtResult;
+}
+
+void PathGenerator::TakeSearchResult(PathSearch const& search)
+{
+    // tiles of the corridor may have been reloaded while it was searched
+    if (dtStatusFailed(search.Status) || !search.PathSize ||
+        !std::all_of(search.Path, search.Path + search.PathSize, [this](dtPolyRef poly) { return _navMesh->isValidPolyRef(poly); }))
+    {
+        _polyLength = 0;
+        return;
+    }
+
+    if (sWorld->getIntConfig(CONFIG_MMAP_PATH_CACHE_DURATION))
+        _source->GetMap()->GetPathCache()->Store(search.EndPoly, search.Filter, search.Status, search.Path, search.PathSize, search.SearchTime, GameTime::GetGameTimeMS());
+
+    std::copy_n(search.Path, search.PathSize, _pathPolyRefs);
+    _polyLength = search.PathSize;
+}
+
 void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
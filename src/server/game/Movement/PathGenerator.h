@@ -23,9 +23,11 @@
 #include "MMapDefines.h"
 #include "MoveSplineInitArgs.h"
 #include <G3D/Vector3.h>
+#include <memory>
 
 class Unit;
 class WorldObject;
+struct PathSearch;
 
 // 74*4.0f=296y number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -51,6 +53,7 @@ enum PathType
     PATHFIND_FARFROMPOLY_START = 0x40,   // start position is far from the mmap poligon
     PATHFIND_FARFROMPOLY_END   = 0x80,   // end positions is far from the mmap poligon
     PATHFIND_FARFROMPOLY       = PATHFIND_FARFROMPOLY_START | PATHFIND_FARFROMPOLY_END, // start or end positions are far from the mmap poligon
+    PATHFIND_PENDING           = 0x100,  // path is being searched on a worker thread, calculate it again on a later update (only with SetUseAsync)
 };
 
 class TC_GAME_API PathGenerator
@@ -68,6 +71,7 @@ class TC_GAME_API PathGenerator
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
         void SetUseRaycast(bool useRaycast) { _useRaycast = useRaycast; }
+        void SetUseAsync(bool useAsync) { _useAsync = useAsync; }
 
         // result getters
         G3D::Vector3 const& GetStartPosition() const { return _startPosition; }
@@ -93,6 +97,9 @@ class TC_GAME_API PathGenerator
         bool _forceDestination; // when set, we will always arrive at given point
         uint32 _pointPathLimit; // limit point path size; min(this, MAX_POINT_PATH_LENGTH)
         bool _useRaycast;       // use raycast if true for a straight line path
+        bool _useAsync;         // long searches may run on a worker thread, the path is PATHFIND_PENDING until a later CalculatePath
+
+        std::shared_ptr<PathSearch> _pendingSearch; // search started by an earlier CalculatePath
 
         G3D::Vector3 _startPosition;        // {x, y, z} of current location
         G3D::Vector3 _endPosition;          // {x, y, z} of the destination
@@ -124,6 +131,11 @@ class TC_GAME_API PathGenerator
         bool HaveTile(G3D::Vector3 const& p) const;
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        // dtNavMeshQuery::findPath, answered from the map's PathCache when another path already went through startPoly to endPoly
+        // with allowAsync a search that is not cached is queued instead and DT_IN_PROGRESS is returned
+        dtStatus FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                              dtPolyRef* path, uint32* pathSize, uint32 maxPathSize, bool allowAsync);
+        void TakeSearchResult(PathSearch const& search);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
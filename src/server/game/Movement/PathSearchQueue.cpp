@@ -0,0 +1,136 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathSearchQueue.h"
+#include "MMapManager.h"
+#include "ThreadPool.h"
+#include <utility>
+
+namespace
+{
+    std::unique_ptr<Trinity::ThreadPool> Workers;
+
+    uint32 MicrosecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+void PathSearchQueue::StartWorkers(uint32 threads)
+{
+    if (threads)
+        Workers = std::make_unique<Trinity::ThreadPool>(threads);
+}
+
+void PathSearchQueue::StopWorkers()
+{
+    if (!Workers)
+        return;
+
+    Workers->Join();
+    Workers = nullptr;
+}
+
+bool PathSearchQueue::HasWorkers()
+{
+    return Workers != nullptr;
+}
+
+bool PathSearchQueue::Submit(std::shared_ptr<PathSearch> search)
+{
+    if (!Workers)
+        return false;
+
+    search->SubmitTime = std::chrono::steady_clock::now();
+    search->Done.store(false, std::memory_order_relaxed);
+    ++_pending;
+
+    Workers->PostWork([this, search = std::move(search)]()
+    {
+        std::shared_lock<std::shared_mutex> navMeshGuard(search->NavMeshLock->mutex);
+        if (NavMeshQueryPtr query = !search->NavMeshLock->unloaded ? AcquireQuery(search->NavMesh) : nullptr)
+        {
+            std::chrono::steady_clock::time_point searchStart = std::chrono::steady_clock::now();
+
+            int pathSize = 0;
+            search->Status = query->findPath(search->StartPoly, search->EndPoly, search->StartPoint, search->EndPoint, &search->Filter,
+                search->Path, &pathSize, MAX_PATH_LENGTH);
+            search->PathSize = uint32(pathSize);
+            search->SearchTime = MicrosecondsSince(searchStart);
+
+            ReleaseQuery(std::move(query));
+        }
+
+        Finish(*search);
+    });
+
+    return true;
+}
+
+PathSearchQueue::NavMeshQueryPtr PathSearchQueue::AcquireQuery(dtNavMesh const* navMesh)
+{
+    NavMeshQueryPtr query;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (!_queries.empty())
+        {
+            query = std::move(_queries.back());
+            _queries.pop_back();
+        }
+    }
+
+    // the navmesh is created again when the map is loaded after all of its instances were unloaded
+    if (query && query->getAttachedNavMesh() == navMesh)
+        return query;
+
+    if (!query)
+        query.reset(dtAllocNavMeshQuery());
+
+    if (!query || dtStatusFailed(query->init(navMesh, 1024)))
+        return nullptr;
+
+    return query;
+}
+
+void PathSearchQueue::ReleaseQuery(NavMeshQueryPtr query)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _queries.push_back(std::move(query));
+}
+
+void PathSearchQueue::Finish(PathSearch& search)
+{
+    uint32 latency = MicrosecondsSince(search.SubmitTime);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _latencies.push_back(latency);
+    search.Done.store(true, std::memory_order_release);
+    if (!--_pending)
+        _allDone.notify_all();
+}
+
+void PathSearchQueue::Wait()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    _allDone.wait(lock, [this]() { return !_pending; });
+}
+
+std::vector<uint32> PathSearchQueue::ConsumeLatencies()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return std::exchange(_latencies, { });
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PATH_SEARCH_QUEUE_H
+#define TRINITY_PATH_SEARCH_QUEUE_H
+
+#include "Define.h"
+#include "PathGenerator.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MMAP
+{
+    struct NavMeshLock;
+}
+
+/// A dtNavMeshQuery::findPath run on a path search worker thread, filled in by PathGenerator.
+struct PathSearch
+{
+    dtNavMesh const* NavMesh = nullptr;
+    std::shared_ptr<MMAP::NavMeshLock> NavMeshLock; // MMapData::navMeshLock of NavMesh
+    dtQueryFilter Filter;
+    dtPolyRef StartPoly = INVALID_POLYREF;
+    dtPolyRef EndPoly = INVALID_POLYREF;
+    float StartPoint[VERTEX_SIZE] = { };
+    float EndPoint[VERTEX_SIZE] = { };
+
+    // results, only to be read once IsDone returns true
+    dtPolyRef Path[MAX_PATH_LENGTH] = { };
+    uint32 PathSize = 0;
+    dtStatus Status = DT_FAILURE;
+    uint32 SearchTime = 0;                  // microseconds spent in findPath
+
+    bool IsDone() const { return Done.load(std::memory_order_acquire); }
+
+private:
+    friend class PathSearchQueue;
+
+    std::chrono::steady_clock::time_point SubmitTime;
+    std::atomic<bool> Done = false;
+};
+
+/// Path searches of one map, run on the worker threads shared by all maps.
+/// Every running search uses its own dtNavMeshQuery, the queue keeps them for its next searches. The navmesh
+/// is shared by all maps with the same id, searches hold its MMapManager lock shared so no tile is added or
+/// removed while they run, and skip the search when the navmesh was unloaded after they were queued.
+class TC_GAME_API PathSearchQueue
+{
+public:
+    PathSearchQueue() : _pending(0) { }
+    ~PathSearchQueue() { Wait(); }
+
+    PathSearchQueue(PathSearchQueue const&) = delete;
+    PathSearchQueue& operator=(PathSearchQueue const&) = delete;
+
+    static void StartWorkers(uint32 threads);
+    static void StopWorkers();
+    static bool HasWorkers();
+
+    /// Queues the search, returns false when there are no workers to run it
+    bool Submit(std::shared_ptr<PathSearch> search);
+
+    /// Returns when every search submitted to this queue is done
+    void Wait();
+
+    /// Returns the number of searches submitted and not done yet
+    uint32 GetPendingCount() const { return _pending.load(std::memory_order_relaxed); }
+
+    /// Returns and resets the time (in microseconds) from submit to done of every search done since the last call
+    std::vector<uint32> ConsumeLatencies();
+
+private:
+    struct NavMeshQueryDeleter
+    {
+        void operator()(dtNavMeshQuery* query) const { dtFreeNavMeshQuery(query); }
+    };
+
+    using NavMeshQueryPtr = std::unique_ptr<dtNavMeshQuery, NavMeshQueryDeleter>;
+
+    NavMeshQueryPtr AcquireQuery(dtNavMesh const* navMesh);
+    void ReleaseQuery(NavMeshQueryPtr query);
+    void Finish(PathSearch& search);
+
+    std::atomic<uint32> _pending;
+    std::mutex _lock;
+    std::condition_variable _allDone;
+    std::vector<uint32> _latencies;
+    std::vector<NavMeshQueryPtr> _queries;          // idle queries, at most one per worker that searched for this map at the same time
+};
+
+#endif // TRINITY_PATH_SEARCH_QUEUE_H
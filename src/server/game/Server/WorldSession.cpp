@@ -207,10 +207,24 @@ ObjectGuid::LowType WorldSession::GetGUIDLow() const
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
-    ASSERT(packet->GetOpcode() != NULL_OPCODE);
+    if (PrepareSendPacket(*packet))
+        m_Socket->SendPacket(*packet);
+}
+
+/// Send a packet shared with other sessions to the client, its payload is not copied
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (PrepareSendPacket(*packet))
+        m_Socket->SendPacket(packet);
+}
+
+/// Common checks, statistics and hooks of SendPacket, returns false if the packet must not be sent
+bool WorldSession::PrepareSendPacket(WorldPacket const& packet)
+{
+    ASSERT(packet.GetOpcode() != NULL_OPCODE);
 
     if (!m_Socket)
-        return;
+        return false;
 
 #ifdef TRINITY_DEBUG
     // Code for network use statistic
@@ -228,10 +242,10 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if ((cur_time - lastTime) < 60)
     {
         sendPacketCount += 1;
-        sendPacketBytes += packet->size();
+        sendPacketBytes += packet.size();
 
         sendLastPacketCount += 1;
-        sendLastPacketBytes += packet->size();
+        sendLastPacketBytes += packet.size();
     }
     else
     {
@@ -242,14 +256,14 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
         lastTime = cur_time;
         sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
+        sendLastPacketBytes = packet.wpos();               // wpos is real written size
     }
 #endif                                                      // !TRINITY_DEBUG
 
-    sScriptMgr->OnPacketSend(this, *packet);
+    sScriptMgr->OnPacketSend(this, packet);
 
-    TC_LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())));
-    m_Socket->SendPacket(*packet);
+    TC_LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())));
+    return true;
 }
 
 /// Add an incoming packet to the queue
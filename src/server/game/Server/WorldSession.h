@@ -454,6 +454,7 @@ class TC_GAME_API WorldSession
         void static WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName *declinedName);
@@ -1170,6 +1171,7 @@ class TC_GAME_API WorldSession
 
     private:
         void ProcessQueryCallbacks();
+        bool PrepareSendPacket(WorldPacket const& packet);
 
         QueryCallbackProcessor _queryProcessor;
         AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
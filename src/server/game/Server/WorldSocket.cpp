@@ -31,12 +31,14 @@
 #include "ScriptMgr.h"
 #include "World.h"
 #include "WorldSession.h"
+#include <boost/asio/post.hpp>
 #include <memory>
 
 using boost::asio::ip::tcp;
 
 WorldSocket::WorldSocket(tcp::socket&& socket)
-    : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096)
+    : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096),
+    _sendQueueFlushScheduled(false)
 {
     Trinity::Crypto::GetRandomBytes(_authSeed);
     _headerBuffer.Resize(sizeof(ClientPktHeader));
@@ -83,38 +85,58 @@ void WorldSocket::CheckIpCallback(PreparedQueryResult result)
 }
 
 bool WorldSocket::Update()
+{
+    SendQueuedPackets();
+
+    if (!BaseSocket::Update())
+        return false;
+
+    _queryProcessor.ProcessReadyCallbacks();
+
+    return true;
+}
+
+void WorldSocket::SendQueuedPackets()
 {
     EncryptablePacket* queued;
     if (_bufferQueue.Dequeue(queued))
     {
         // Allocate buffer only when it's needed but not on every Update() call.
+        // Small packets are coalesced into it, larger ones are written from their own storage with a gather write
         MessageBuffer buffer(_sendBufferSize);
         do
         {
-            ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+            WorldPacket const& packet = queued->GetPacket();
+            ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
             if (queued->NeedsEncryption())
                 _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-            if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
-            {
-                QueuePacket(std::move(buffer));
-                buffer.Resize(_sendBufferSize);
-            }
-
-            if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
+            if (buffer.GetRemainingSpace() >= packet.size() + header.getHeaderLength())
             {
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
-            else    // single packet larger than buffer size
+            else    // packet does not fit in the current buffer, send its payload straight from packet storage
             {
-                MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
-                packetBuffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    packetBuffer.Write(queued->contents(), queued->size());
+                if (buffer.GetRemainingSpace() < header.getHeaderLength())
+                {
+                    QueuePacket(std::move(buffer));
+                    buffer.Resize(_sendBufferSize);
+                }
+
+                buffer.Write(header.header, header.getHeaderLength());
+                QueuePacket(std::move(buffer));
+                buffer.Resize(_sendBufferSize);
 
-                QueuePacket(std::move(packetBuffer));
+                if (!packet.empty())
+                {
+                    // shared payloads are still referenced by other sockets and have to be copied
+                    if (queued->IsShared())
+                        QueuePacket(MessageBuffer(std::vector<uint8>(packet.contents(), packet.contents() + packet.size())));
+                    else
+                        QueuePacket(MessageBuffer(queued->Move()));
+                }
             }
 
             delete queued;
@@ -123,13 +145,17 @@ bool WorldSocket::Update()
         if (buffer.GetActiveSize() > 0)
             QueuePacket(std::move(buffer));
     }
+}
 
-    if (!BaseSocket::Update())
-        return false;
+void WorldSocket::FlushSendQueue()
+{
+    // clear the flag before draining so packets queued meanwhile schedule another flush
+    _sendQueueFlushScheduled.store(false, std::memory_order_release);
 
-    _queryProcessor.ProcessReadyCallbacks();
+    SendQueuedPackets();
 
-    return true;
+    // starts the write of what was just queued, closed sockets are cleaned up by NetworkThread::Update
+    BaseSocket::Update();
 }
 
 void WorldSocket::HandleSendAuthSession()
@@ -426,7 +452,27 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
-    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+    EnqueuePacket(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    EnqueuePacket(new EncryptablePacket(std::move(packet), _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::EnqueuePacket(EncryptablePacket* packet)
+{
+    _bufferQueue.Enqueue(packet);
+
+    // wake the network thread once per batch instead of waiting for its next periodic update
+    if (!_sendQueueFlushScheduled.exchange(true, std::memory_order_acq_rel))
+        boost::asio::post(underlying_stream().get_executor(), [self = shared_from_this()]() { self->FlushSendQueue(); });
 }
 
 void WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
@@ -37,11 +37,21 @@ public:
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    /// references a payload shared with other sockets instead of copying it, only the header is written per socket
+    EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : _sharedPacket(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    WorldPacket const& GetPacket() const { return _sharedPacket ? *_sharedPacket : *this; }
+    bool IsShared() const { return _sharedPacket != nullptr; }
+
     bool NeedsEncryption() const { return _encrypt; }
 
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
+    std::shared_ptr<WorldPacket const> _sharedPacket;
     bool _encrypt;
 };
 
@@ -79,6 +89,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -99,6 +110,13 @@ protected:
 private:
     void CheckIpCallback(PreparedQueryResult result);
 
+    void EnqueuePacket(EncryptablePacket* packet);
+
+    /// moves packets from _bufferQueue to the socket write queue, must only be called from the network thread
+    void SendQueuedPackets();
+    /// handler posted to the network thread by SendPacket
+    void FlushSendQueue();
+
     /// writes network.opcode log
     /// accessing WorldSession is not threadsafe, only do it when holding _worldSessionLock
     void LogOpcodeText(OpcodeClient opcode, std::unique_lock<std::mutex> const& guard) const;
@@ -126,6 +144,7 @@ private:
     MessageBuffer _packetBuffer;
     MPSCQueue<EncryptablePacket, &EncryptablePacket::SocketQueueLink> _bufferQueue;
     std::size_t _sendBufferSize;
+    std::atomic<bool> _sendQueueFlushScheduled;
 
     QueryCallbackProcessor _queryProcessor;
     std::string _ipCountry;
@@ -31,6 +31,9 @@ static void OnSocketAccept(tcp::socket&& sock, uint32 threadIndex)
 class WorldSocketThread : public NetworkThread<WorldSocket>
 {
 public:
+    // WorldSocket::SendPacket wakes the thread itself, periodic update only handles housekeeping
+    WorldSocketThread() : NetworkThread<WorldSocket>(10ms) { }
+
     void SocketAdded(std::shared_ptr<WorldSocket> sock) override
     {
         sock->SetSendBufferSize(sWorldSocketMgr.GetApplicationSendBufferSize());
@@ -657,6 +657,17 @@ void AuraEffect::CalculateSpellMod()
     GetBase()->CallScriptEffectCalcSpellModHandlers(this, m_spellmod);
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    _amount = amount;
+    m_canBeRecalculated = false;
+
+    // targets cache their aura modifier totals, which depend on the amount
+    for (auto const& [guid, aurApp] : GetBase()->GetApplicationMap())
+        if (aurApp->HasEffect(GetEffIndex()))
+            aurApp->GetTarget()->_InvalidateAuraModifierCache(GetAuraType());
+}
+
 void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
 {
     // Reapply if amount change
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupLoader.h"
+#include "Log.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+namespace
+{
+    bool SharesStore(std::vector<std::string> const& left, std::vector<std::string> const& right)
+    {
+        return std::any_of(left.begin(), left.end(), [&](std::string const& store)
+        {
+            return std::find(right.begin(), right.end(), store) != right.end();
+        });
+    }
+}
+
+void StartupLoader::AddStep(std::string name, StoreList reads, StoreList writes, std::function<void()> load)
+{
+    Step& step = _steps.emplace_back();
+    step.Name = std::move(name);
+    step.Reads.assign(reads.begin(), reads.end());
+    step.Writes.assign(writes.begin(), writes.end());
+    step.Load = std::move(load);
+
+    std::size_t index = _steps.size() - 1;
+    for (std::size_t i = 0; i < index; ++i)
+    {
+        Step& previous = _steps[i];
+        if (SharesStore(previous.Writes, step.Reads) || SharesStore(previous.Writes, step.Writes) || SharesStore(previous.Reads, step.Writes))
+        {
+            step.Dependencies.push_back(i);
+            previous.Dependents.push_back(index);
+        }
+    }
+}
+
+void StartupLoader::RunStep(Step& step, uint32 runStartTime)
+{
+    TC_LOG_INFO("server.loading", "Loading {}...", step.Name);
+
+    uint32 startTime = getMSTime();
+    step.StartTime = getMSTimeDiff(runStartTime, startTime);
+    step.Load();
+    step.Duration = GetMSTimeDiffToNow(startTime);
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 runStartTime = getMSTime();
+
+    if (threads <= 1)
+    {
+        for (Step& step : _steps)
+            RunStep(step, runStartTime);
+    }
+    else if (!_steps.empty())
+    {
+        std::mutex lock;
+        std::condition_variable allDone;
+        std::size_t remainingSteps = _steps.size();
+        std::vector<std::size_t> remainingDependencies(_steps.size());
+        for (std::size_t i = 0; i < _steps.size(); ++i)
+            remainingDependencies[i] = _steps[i].Dependencies.size();
+
+        Trinity::ThreadPool pool(threads);
+
+        std::function<void(std::size_t)> runStep = [&](std::size_t index)
+        {
+            RunStep(_steps[index], runStartTime);
+
+            std::lock_guard<std::mutex> guard(lock);
+            for (std::size_t dependent : _steps[index].Dependents)
+                if (!--remainingDependencies[dependent])
+                    pool.PostWork([&runStep, dependent]() { runStep(dependent); });
+
+            if (!--remainingSteps)
+                allDone.notify_one();
+        };
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            for (std::size_t i = 0; i < _steps.size(); ++i)
+                if (!remainingDependencies[i])
+                    pool.PostWork([&runStep, i]() { runStep(i); });
+
+            allDone.wait(guard, [&]() { return !remainingSteps; });
+        }
+
+        pool.Join();
+    }
+
+    LogSummary(threads, GetMSTimeDiffToNow(runStartTime));
+}
+
+void StartupLoader::LogSummary(uint32 threads, uint32 wallTime) const
+{
+    // longest chain of dependent steps, dependencies always come before their dependents
+    std::vector<uint32> chainTime(_steps.size());
+    std::vector<std::size_t> chainPrevious(_steps.size(), _steps.size());
+    std::size_t chainEnd = _steps.size();
+    for (std::size_t i = 0; i < _steps.size(); ++i)
+    {
+        for (std::size_t dependency : _steps[i].Dependencies)
+        {
+            if (chainTime[dependency] > chainTime[i])
+            {
+                chainTime[i] = chainTime[dependency];
+                chainPrevious[i] = dependency;
+            }
+        }
+
+        chainTime[i] += _steps[i].Duration;
+        if (chainEnd == _steps.size() || chainTime[i] > chainTime[chainEnd])
+            chainEnd = i;
+    }
+
+    std::vector<bool> critical(_steps.size(), false);
+    for (std::size_t i = chainEnd; i < _steps.size(); i = chainPrevious[i])
+        critical[i] = true;
+
+    uint32 stepsTime = 0;
+    for (Step const& step : _steps)
+        stepsTime += step.Duration;
+
+    TC_LOG_INFO("server.loading", ">> {}: {} steps loaded in {} ms on {} thread(s), {} ms of loading in total, critical path {} ms",
+        _name, _steps.size(), wallTime, std::max(threads, 1u), stepsTime, chainEnd < _steps.size() ? chainTime[chainEnd] : 0);
+    TC_LOG_INFO("server.loading", "   {:<48} {:>8} {:>8}", "Step", "Start", "Time");
+    for (std::size_t i = 0; i < _steps.size(); ++i)
+        TC_LOG_INFO("server.loading", " {} {:<48} {:>8} {:>8}", critical[i] ? '*' : ' ', _steps[i].Name, _steps[i].StartTime, _steps[i].Duration);
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_STARTUP_LOADER_H
+#define TRINITY_STARTUP_LOADER_H
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Runs world data loading steps, concurrently when they do not share any data.
+/// Every step names the stores (any label, usually the table or container) it reads and writes.
+/// Steps are added in the order they have to run in when loaded one after another: a step waits for
+/// all earlier steps that write a store it reads or writes and for all earlier steps that read a store it writes.
+class TC_GAME_API StartupLoader
+{
+public:
+    using StoreList = std::initializer_list<std::string_view>;
+
+    explicit StartupLoader(std::string name) : _name(std::move(name)) { }
+
+    StartupLoader(StartupLoader const&) = delete;
+    StartupLoader& operator=(StartupLoader const&) = delete;
+
+    void AddStep(std::string name, StoreList reads, StoreList writes, std::function<void()> load);
+
+    /// Runs all steps on up to threads threads and logs their timings, returns when all are done.
+    /// With a single thread the steps run on the calling thread in the order they were added.
+    void Run(uint32 threads);
+
+private:
+    struct Step
+    {
+        std::string Name;
+        std::vector<std::string> Reads;
+        std::vector<std::string> Writes;
+        std::function<void()> Load;
+        std::vector<std::size_t> Dependencies;
+        std::vector<std::size_t> Dependents;
+        uint32 StartTime = 0;               // ms since Run began
+        uint32 Duration = 0;                // ms
+    };
+
+    void RunStep(Step& step, uint32 runStartTime);
+    void LogSummary(uint32 threads, uint32 wallTime) const;
+
+    std::string _name;
+    std::vector<Step> _steps;
+};
+
+#endif // TRINITY_STARTUP_LOADER_H
@@ -77,6 +77,7 @@
 #include "SkillExtraItems.h"
 #include "SmartScriptMgr.h"
 #include "SpellMgr.h"
+#include "StartupLoader.h"
 #include "TicketMgr.h"
 #include "TransportMgr.h"
 #include "Unit.h"
@@ -1397,6 +1398,8 @@ void World::LoadConfigSettings(bool reload)
     }
 
     _boolConfigs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", true);
+    _boolConfigs[CONFIG_MMAP_PREFETCH_ADJACENT_TILES] = sConfigMgr->GetBoolDefault("mmap.prefetchAdjacentTiles", true);
+    _intConfigs[CONFIG_MMAP_PATH_CACHE_DURATION] = sConfigMgr->GetIntDefault("mmap.pathCacheDuration", 500);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: {}mmaps", _dataPath);
 
     _boolConfigs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", false);
@@ -1433,6 +1436,10 @@ void World::LoadConfigSettings(bool reload)
     _boolConfigs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     _boolConfigs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     _intConfigs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    _intConfigs[CONFIG_MAP_UPDATE_PARALLEL_SEND_MIN_PLAYERS] = sConfigMgr->GetIntDefault("MapUpdate.ParallelSend.MinPlayers", 0);
+    _intConfigs[CONFIG_MAP_UPDATE_ISLANDS_MIN_PLAYERS] = sConfigMgr->GetIntDefault("MapUpdate.Islands.MinPlayers", 0);
+    _intConfigs[CONFIG_STARTUP_LOADER_THREADS] = sConfigMgr->GetIntDefault("Startup.LoaderThreads", 1);
+    _intConfigs[CONFIG_PATH_SEARCH_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.PathThreads", 0);
     _intConfigs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1924,145 +1931,68 @@ bool World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading linked spells...");
     sSpellMgr->LoadSpellLinked();
 
-    TC_LOG_INFO("server.loading", "Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
-
-    TC_LOG_INFO("server.loading", "Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
-
+    // Must be done before anything below reads character data
     CharacterDatabaseCleaner::CleanDatabase();
 
-    TC_LOG_INFO("server.loading", "Loading the max pet number...");
-    sObjectMgr->LoadPetNumber();
-
-    TC_LOG_INFO("server.loading", "Loading pet level stats...");
-    sObjectMgr->LoadPetLevelInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Player level dependent mail rewards...");
-    sObjectMgr->LoadMailLevelRewards();
-
-    // Loot tables
-    LoadLootTables();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    TC_LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    uint32 loaderThreads = getIntConfig(CONFIG_STARTUP_LOADER_THREADS);
+
+    StartupLoader loader("World data");
+    loader.AddStep("Player Create Data", { "item_template", "spells" }, { "playercreateinfo" }, []() { sObjectMgr->LoadPlayerInfo(); });
+    loader.AddStep("Exploration BaseXP Data", { }, { "exploration_basexp" }, []() { sObjectMgr->LoadExplorationBaseXP(); });
+    loader.AddStep("Pet Name Parts", { }, { "pet_name_generation" }, []() { sObjectMgr->LoadPetNames(); });
+    loader.AddStep("the max pet number", { "characters" }, { "pet_number" }, []() { sObjectMgr->LoadPetNumber(); });
+    loader.AddStep("pet level stats", { "creature_template" }, { "pet_levelstats" }, []() { sObjectMgr->LoadPetLevelInfo(); });
+    loader.AddStep("Player level dependent mail rewards", { }, { "mail_level_reward" }, []() { sObjectMgr->LoadMailLevelRewards(); });
+    loader.AddStep("Loot tables", { "creature_template", "gameobject_template", "item_template", "spells" }, { "loot" }, []() { LoadLootTables(); });
+    loader.AddStep("Skill Discovery Table", { "spells" }, { "skill_discovery" }, []() { LoadSkillDiscoveryTable(); });
+    loader.AddStep("Skill Extra Item Table", { "spells" }, { "skill_extra_item" }, []() { LoadSkillExtraItemTable(); });
+    loader.AddStep("Skill Perfection Data Table", { "spells" }, { "skill_perfect_item" }, []() { LoadSkillPerfectItemTable(); });
+    loader.AddStep("Skill Fishing base level requirements", { }, { "skill_fishing_base_level" }, []() { sObjectMgr->LoadFishingBaseSkillLevel(); });
+    loader.AddStep("Achievements", { }, { "achievements" }, []() { sAchievementMgr->LoadAchievementReferenceList(); });
+    loader.AddStep("Achievement Criteria Lists", { }, { "achievements" }, []() { sAchievementMgr->LoadAchievementCriteriaList(); });
+    loader.AddStep("Achievement Criteria Data", { "creature_template", "item_template", "spells" }, { "achievements" }, []() { sAchievementMgr->LoadAchievementCriteriaData(); });
+    loader.AddStep("Achievement Rewards", { "creature_template", "item_template" }, { "achievements" }, []() { sAchievementMgr->LoadRewards(); });
+    loader.AddStep("Achievement Reward Locales", { }, { "achievements" }, []() { sAchievementMgr->LoadRewardLocales(); });
+    loader.AddStep("Completed Achievements", { }, { "achievements", "characters" }, []() { sAchievementMgr->LoadCompletedAchievements(); });
 
     ///- Load dynamic data tables from the database
-    TC_LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-
-    TC_LOG_INFO("server.loading", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
-
-    TC_LOG_INFO("server.loading", "Loading Guilds...");
-    sGuildMgr->LoadGuilds();
-
-    TC_LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
-
-    TC_LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
-
-    TC_LOG_INFO("server.loading", "Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
-
-    TC_LOG_INFO("server.loading", "Loading GameObjects for quests...");
-    sObjectMgr->LoadGameObjectForQuests();
-
-    TC_LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();                 // must be after load CreatureTemplate
-
-    TC_LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    TC_LOG_INFO("server.loading", "Loading Trainers...");       // must be after LoadCreatureTemplates
-    sObjectMgr->LoadTrainers();
-
-    TC_LOG_INFO("server.loading", "Loading Creature default trainers...");
-    sObjectMgr->LoadCreatureDefaultTrainers();
-
-    TC_LOG_INFO("server.loading", "Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
-
-    TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();                           // must be after LoadTrainers
-
-    TC_LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    TC_LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
-
-    TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
-
-    TC_LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
-    LoadWorldStates();
+    loader.AddStep("Item Auctions", { "item_template" }, { "auctions", "characters" }, []() { sAuctionMgr->LoadAuctionItems(); });
+    loader.AddStep("Auctions", { }, { "auctions", "characters" }, []() { sAuctionMgr->LoadAuctions(); });
+    loader.AddStep("Guilds", { "item_template" }, { "guilds", "character_cache", "characters" }, []() { sGuildMgr->LoadGuilds(); });
+    loader.AddStep("ArenaTeams", { }, { "arena_teams", "character_cache", "characters" }, []() { sArenaTeamMgr->LoadArenaTeams(); });
+    loader.AddStep("Groups", { "character_cache" }, { "groups", "instance_saves", "characters" }, []() { sGroupMgr->LoadGroups(); });
+    loader.AddStep("ReservedNames", { "characters" }, { "reserved_name" }, []() { sObjectMgr->LoadReservedPlayersNames(); });
+    loader.AddStep("GameObjects for quests", { "gameobject_template", "loot" }, { "gameobject_for_quests" }, []() { sObjectMgr->LoadGameObjectForQuests(); });
+    loader.AddStep("BattleMasters", { }, { "battlemaster_entry", "creature_template" }, []() { sBattlegroundMgr->LoadBattleMastersEntry(); });    // clears UNIT_NPC_FLAG_BATTLEMASTER of creatures without an entry
+    loader.AddStep("GameTeleports", { }, { "game_tele" }, []() { sObjectMgr->LoadGameTele(); });
+    loader.AddStep("Trainers", { "spells" }, { "trainer" }, []() { sObjectMgr->LoadTrainers(); });
+    loader.AddStep("Creature default trainers", { "creature_template", "trainer" }, { "creature_default_trainer" }, []() { sObjectMgr->LoadCreatureDefaultTrainers(); });
+    loader.AddStep("Gossip menu", { "npc_text" }, { "gossip_menu" }, []() { sObjectMgr->LoadGossipMenu(); });
+    loader.AddStep("Gossip menu options", { "broadcast_text", "points_of_interest", "trainer" }, { "gossip_menu_option" }, []() { sObjectMgr->LoadGossipMenuItems(); });
+    loader.AddStep("Vendors", { "creature_template", "item_template" }, { "npc_vendor" }, []() { sObjectMgr->LoadVendors(); });
+    loader.AddStep("Waypoints", { }, { "waypoint_data" }, []() { sWaypointMgr->Load(); });
+    loader.AddStep("SmartAI Waypoints", { }, { "waypoints" }, []() { sSmartWaypointMgr->LoadFromDB(); });
+    loader.AddStep("Creature Formations", { "creature" }, { "creature_formations" }, []() { sFormationMgr->LoadCreatureFormations(); });
+    loader.AddStep("World States", { "characters" }, { "world_states" }, [this]() { LoadWorldStates(); });      // must be loaded before battleground, outdoor PvP and conditions
+    loader.Run(loaderThreads);
 
     TC_LOG_INFO("server.loading", "Loading Conditions...");
     sConditionMgr->LoadConditions();
 
-    TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
-
-    TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
-
-    TC_LOG_INFO("server.loading", "Loading faction change quest pairs...");
-    sObjectMgr->LoadFactionChangeQuests();
-
-    TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
-
-    TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
-
-    TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
-
-    TC_LOG_INFO("server.loading", "Loading GM tickets...");
-    sTicketMgr->LoadTickets();
-
-    TC_LOG_INFO("server.loading", "Loading GM surveys...");
-    sTicketMgr->LoadSurveys();
-
-    TC_LOG_INFO("server.loading", "Loading client addons...");
-    AddonMgr::LoadFromDB();
-
+    StartupLoader lateLoader("Late world data");
+    lateLoader.AddStep("faction change achievement pairs", { }, { "player_factionchange_achievement" }, []() { sObjectMgr->LoadFactionChangeAchievements(); });
+    lateLoader.AddStep("faction change spell pairs", { "spells" }, { "player_factionchange_spells" }, []() { sObjectMgr->LoadFactionChangeSpells(); });
+    lateLoader.AddStep("faction change quest pairs", { "quest_template" }, { "player_factionchange_quests" }, []() { sObjectMgr->LoadFactionChangeQuests(); });
+    lateLoader.AddStep("faction change item pairs", { "item_template" }, { "player_factionchange_items" }, []() { sObjectMgr->LoadFactionChangeItems(); });
+    lateLoader.AddStep("faction change reputation pairs", { }, { "player_factionchange_reputations" }, []() { sObjectMgr->LoadFactionChangeReputations(); });
+    lateLoader.AddStep("faction change title pairs", { }, { "player_factionchange_titles" }, []() { sObjectMgr->LoadFactionChangeTitles(); });
+    lateLoader.AddStep("GM tickets", { "characters" }, { "gm_ticket" }, []() { sTicketMgr->LoadTickets(); });
+    lateLoader.AddStep("GM surveys", { "characters" }, { "gm_survey" }, []() { sTicketMgr->LoadSurveys(); });
+    lateLoader.AddStep("client addons", { "characters" }, { "addons" }, []() { AddonMgr::LoadFromDB(); });
     ///- Handle outdated emails (delete/return)
-    TC_LOG_INFO("server.loading", "Returning old mails...");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
-
-    TC_LOG_INFO("server.loading", "Loading Autobroadcasts...");
-    LoadAutobroadcasts();
+    lateLoader.AddStep("old mails to return", { }, { "characters" }, []() { sObjectMgr->ReturnOrDeleteOldMails(false); });
+    lateLoader.AddStep("Autobroadcasts", { }, { "autobroadcast" }, [this]() { LoadAutobroadcasts(); });
+    lateLoader.Run(loaderThreads);
 
     ///- Load and initialize scripts
     sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
@@ -154,6 +154,7 @@ enum WorldBoolConfigs : uint32
     CONFIG_QUEST_ENABLE_QUEST_TRACKER,
     CONFIG_WARDEN_ENABLED,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_MMAP_PREFETCH_ADJACENT_TILES,
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_EVENT_ANNOUNCE,
     CONFIG_STATS_LIMITS_ENABLE,
@@ -330,6 +331,11 @@ enum WorldIntConfigs : uint32
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_UPDATE_PARALLEL_SEND_MIN_PLAYERS,
+    CONFIG_MAP_UPDATE_ISLANDS_MIN_PLAYERS,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_MMAP_PATH_CACHE_DURATION,
+    CONFIG_PATH_SEARCH_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -40,12 +40,17 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
 
     _fieldCount = dbc.GetCols();
 
-    // load raw non-string data
-    _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
+    // records laid out like the structure are used straight from the mapped file, only the index is built
+    if (!dbc.AutoProduceIndex(_fileFormat, _indexTableSize, indexTable))
+    {
+        // load raw non-string data
+        _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
-    // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+        // load strings from dbc data
+        dbc.AutoProduceStrings(_fileFormat, _dataTable);
+    }
+
+    _files.push_back(dbc.ReleaseFile());
 
     // error in dbc file at loading if NULL
     return indexTable != nullptr;
@@ -62,9 +67,9 @@ bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
     if (!dbc.Load(path, _fileFormat))
         return false;
 
-    // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    // load strings from another locale dbc data, records used in place have no strings
+    if (_dataTable && dbc.AutoProduceStrings(_fileFormat, _dataTable))
+        _files.push_back(dbc.ReleaseFile());
 
     return true;
 }
@@ -21,6 +21,8 @@
 #include "Common.h"
 #include "DBCStorageIterator.h"
 #include "Errors.h"
+#include "MappedFile.h"
+#include <memory>
 #include <vector>
 
  /// Interface class for common access
@@ -46,6 +48,7 @@ class TC_SHARED_API DBCStorageBase
         char const* _fileFormat;
         char* _dataTable;
         std::vector<char*> _stringPool;
+        std::vector<std::unique_ptr<Trinity::MappedFile>> _files;   // records used in place and strings point into these
         uint32 _indexTableSize;
 };
 
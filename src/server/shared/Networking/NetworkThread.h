@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DeadlineTimer.h"
+#include "Duration.h"
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
@@ -38,8 +39,10 @@ template<class SocketType>
 class NetworkThread
 {
 public:
-    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
-        _acceptSocket(_ioContext), _updateTimer(_ioContext)
+    /// @param updateInterval how often every socket is polled through SocketType::Update
+    ///        socket types that wake the thread themselves when they have data to send can use a longer interval
+    explicit NetworkThread(Milliseconds updateInterval = 1ms) : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
+        _acceptSocket(_ioContext), _updateTimer(_ioContext), _updateInterval(updateInterval)
     {
     }
 
@@ -122,7 +125,7 @@ protected:
     {
         TC_LOG_DEBUG("misc", "Network Thread Starting");
 
-        _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
+        _updateTimer.expires_from_now(boost::posix_time::milliseconds(_updateInterval.count()));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
         _ioContext.run();
 
@@ -136,7 +139,7 @@ protected:
         if (_stopped)
             return;
 
-        _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
+        _updateTimer.expires_from_now(boost::posix_time::milliseconds(_updateInterval.count()));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
 
         AddNewSockets();
@@ -174,6 +177,7 @@ private:
     Trinity::Asio::IoContext _ioContext;
     tcp::socket _acceptSocket;
     Trinity::Asio::DeadlineTimer _updateTimer;
+    Milliseconds _updateInterval;
 };
 
 #endif // NetworkThread_h__
@@ -20,16 +20,19 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <algorithm>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/container/static_vector.hpp>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+#define MAX_GATHER_WRITE_BUFFERS 16
 #ifdef BOOST_ASIO_HAS_IOCP
 #define TC_SOCKET_USE_IOCP
 #endif
@@ -136,7 +139,7 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -184,8 +187,9 @@ protected:
         _isWritingAsync = true;
 
 #ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()),
+        WriteBufferSequence buffers;
+        GatherWriteBuffers(buffers);
+        _socket.async_write_some(buffers,
             [self = this->shared_from_this()](boost::system::error_code const& error, std::size_t transferedBytes)
             {
                 self->WriteHandler(error, transferedBytes);
@@ -228,6 +232,35 @@ private:
         ReadHandler();
     }
 
+    typedef boost::container::static_vector<boost::asio::const_buffer, MAX_GATHER_WRITE_BUFFERS> WriteBufferSequence;
+
+    /// Collects the front of the write queue into a single scatter/gather write
+    std::size_t GatherWriteBuffers(WriteBufferSequence& buffers)
+    {
+        std::size_t bytes = 0;
+        for (auto itr = _writeQueue.begin(); itr != _writeQueue.end() && buffers.size() < buffers.capacity(); ++itr)
+        {
+            buffers.emplace_back(itr->GetReadPointer(), itr->GetActiveSize());
+            bytes += itr->GetActiveSize();
+        }
+
+        return bytes;
+    }
+
+    /// Releases buffers that were fully sent and advances the partially sent one
+    void WriteCompleted(std::size_t bytes)
+    {
+        while (bytes && !_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            std::size_t consumed = std::min(bytes, buffer.GetActiveSize());
+            buffer.ReadCompleted(consumed);
+            bytes -= consumed;
+            if (!buffer.GetActiveSize())
+                _writeQueue.pop_front();
+        }
+    }
+
 #ifdef TC_SOCKET_USE_IOCP
 
     void WriteHandler(boost::system::error_code const& error, std::size_t transferedBytes)
@@ -235,9 +268,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -253,7 +284,10 @@ private:
     void WriteHandlerWrapper(boost::system::error_code const& /*error*/, std::size_t /*transferedBytes*/)
     {
         _isWritingAsync = false;
-        HandleQueue();
+
+        // keep writing until the queue is drained or the socket would block again
+        for (; HandleQueue();)
+            ;
     }
 
     bool HandleQueue()
@@ -261,37 +295,35 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        WriteBufferSequence buffers;
+        std::size_t bytesToSend = GatherWriteBuffers(buffers);
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(buffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
-        {
-            queuedMessage.ReadCompleted(bytesSent);
+
+        WriteCompleted(bytesSent);
+
+        if (bytesSent < bytesToSend) // now n > 0
             return AsyncProcessQueue();
-        }
 
-        _writeQueue.pop();
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -305,7 +337,7 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
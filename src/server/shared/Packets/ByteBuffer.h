@@ -126,6 +126,13 @@ class TC_SHARED_API ByteBuffer
             _rpos = _wpos = 0;
         }
 
+        // Releases the underlying storage, leaving the buffer empty
+        std::vector<uint8>&& Move() noexcept
+        {
+            _rpos = _wpos = 0;
+            return std::move(_storage);
+        }
+
         template <typename T> void append(T value)
         {
             static_assert(std::is_fundamental<T>::value, "append(compound)");
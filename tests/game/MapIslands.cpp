@@ -0,0 +1,182 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MapIslands.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace
+{
+    CellArea Area(uint32 x, uint32 y, uint32 radius)
+    {
+        return CellArea(CellCoord(x - radius, y - radius), CellCoord(x + radius, y + radius));
+    }
+
+    bool Overlap(CellArea const& left, CellArea const& right, uint32 halo)
+    {
+        return left.low_bound.x_coord <= right.high_bound.x_coord + 2 * halo && right.low_bound.x_coord <= left.high_bound.x_coord + 2 * halo
+            && left.low_bound.y_coord <= right.high_bound.y_coord + 2 * halo && right.low_bound.y_coord <= left.high_bound.y_coord + 2 * halo;
+    }
+}
+
+TEST_CASE("Sources far apart are put into different islands", "[MapIslands]")
+{
+    MapIslandPartition partition(2);
+    partition.AddSource(Area(100, 100, 2));
+    partition.AddSource(Area(200, 200, 2));
+    partition.AddSource(Area(300, 100, 2));
+
+    REQUIRE(partition.Build() == 3);
+    REQUIRE(partition.GetIsland(0) == 0);
+    REQUIRE(partition.GetIsland(1) == 1);
+    REQUIRE(partition.GetIsland(2) == 2);
+}
+
+TEST_CASE("Sources whose halos overlap share an island", "[MapIslands]")
+{
+    MapIslandPartition partition(2);
+    partition.AddSource(Area(100, 100, 2));
+    partition.AddSource(Area(200, 200, 2));
+    // 8 cells from the first source: both halos reach cell 104
+    partition.AddSource(Area(108, 100, 2));
+    // 11 cells further: the halos end at cells 112 and 115, two blocks of 2 cells apart
+    partition.AddSource(Area(119, 100, 2));
+
+    REQUIRE(partition.Build() == 3);
+    REQUIRE(partition.GetIsland(0) == 0);
+    REQUIRE(partition.GetIsland(1) == 1);
+    REQUIRE(partition.GetIsland(2) == 0);
+    REQUIRE(partition.GetIsland(3) == 2);
+}
+
+TEST_CASE("Overlap is transitive", "[MapIslands]")
+{
+    MapIslandPartition partition(1);
+    for (uint32 i = 0; i < 10; ++i)
+        partition.AddSource(Area(100 + i * 4, 100, 1));
+
+    REQUIRE(partition.Build() == 1);
+}
+
+TEST_CASE("Linked sources share an island however far apart they are", "[MapIslands]")
+{
+    MapIslandPartition partition(2);
+    uint32 player = partition.AddSource(Area(50, 50, 2));
+    partition.AddSource(Area(200, 200, 2));
+    partition.AddSource(Area(450, 450, 2), player);
+
+    REQUIRE(partition.Build() == 2);
+    REQUIRE(partition.GetIsland(2) == partition.GetIsland(player));
+    REQUIRE(partition.GetIsland(1) != partition.GetIsland(player));
+}
+
+TEST_CASE("Sources linked after they were added share an island", "[MapIslands]")
+{
+    MapIslandPartition partition(2);
+    uint32 first = partition.AddSource(Area(50, 50, 2));
+    partition.AddSource(Area(200, 200, 2));
+    uint32 second = partition.AddSource(Area(450, 450, 2));
+    partition.Link(second, first);
+
+    REQUIRE(partition.Build() == 2);
+    REQUIRE(partition.GetIsland(first) == 0);
+    REQUIRE(partition.GetIsland(second) == 0);
+    REQUIRE(partition.GetIsland(1) == 1);
+}
+
+TEST_CASE("Halos are clamped to the map", "[MapIslands]")
+{
+    MapIslandPartition partition(8);
+    partition.AddSource(CellArea(CellCoord(0, 0), CellCoord(1, 1)));
+    partition.AddSource(CellArea(CellCoord(TOTAL_NUMBER_OF_CELLS_PER_MAP - 2, TOTAL_NUMBER_OF_CELLS_PER_MAP - 2),
+        CellCoord(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1)));
+
+    REQUIRE(partition.Build() == 2);
+}
+
+TEST_CASE("A cleared partition can be built again", "[MapIslands]")
+{
+    MapIslandPartition partition(2);
+    partition.AddSource(Area(100, 100, 2));
+    partition.AddSource(Area(104, 100, 2));
+    REQUIRE(partition.Build() == 1);
+
+    partition.Clear();
+    REQUIRE(partition.GetSourceCount() == 0);
+
+    // cells owned during the previous build must not join these sources
+    partition.AddSource(Area(300, 300, 2));
+    partition.AddSource(Area(100, 100, 2));
+    REQUIRE(partition.Build() == 2);
+}
+
+// Load harness: players spread over a continent the way they gather around towns and quest hubs.
+// Reports how many islands a map update can run at the same time and how long partitioning takes.
+// Not run by default, start it with: tests "[MapIslandsLoad]"
+TEST_CASE("Island partition load", "[.][MapIslandsLoad]")
+{
+    // halo of a continent with the default visibility range: (400 + 40) yards, see Map::UpdateIslands
+    uint32 const haloCells = 7;
+    uint32 const activationCells = 2;
+    std::mt19937 rng(12345);
+
+    // the map keeps its partition between updates
+    MapIslandPartition partition(haloCells);
+    for (uint32 players : { 200, 1000, 3000 })
+    {
+        for (uint32 hubs : { 20, 60, 150 })
+        {
+            std::uniform_int_distribution<uint32> hubCoord(64, TOTAL_NUMBER_OF_CELLS_PER_MAP - 64);
+            std::vector<CellCoord> hubCenters;
+            for (uint32 i = 0; i < hubs; ++i)
+                hubCenters.emplace_back(hubCoord(rng), hubCoord(rng));
+
+            std::uniform_int_distribution<uint32> pickHub(0, hubs - 1);
+            std::normal_distribution<float> spread(0.0f, 6.0f);
+
+            partition.Clear();
+            for (uint32 i = 0; i < players; ++i)
+            {
+                CellCoord const& hub = hubCenters[pickHub(rng)];
+                uint32 x = uint32(std::clamp(float(hub.x_coord) + spread(rng), float(activationCells), float(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1 - activationCells)));
+                uint32 y = uint32(std::clamp(float(hub.y_coord) + spread(rng), float(activationCells), float(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1 - activationCells)));
+                partition.AddSource(Area(x, y, activationCells));
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            uint32 islandCount = partition.Build();
+            auto buildTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+            std::vector<uint32> islandSizes(islandCount);
+            for (uint32 source = 0; source < partition.GetSourceCount(); ++source)
+                ++islandSizes[partition.GetIsland(source)];
+
+            uint32 largest = *std::max_element(islandSizes.begin(), islandSizes.end());
+            WARN(players << " players around " << hubs << " hubs: " << islandCount << " islands, largest holds "
+                << largest << " players (" << (100 * largest / players) << "%), built in " << buildTime.count() << " us");
+
+            // no two sources of different islands may come within two halos of each other
+            for (uint32 left = 0; left < partition.GetSourceCount(); ++left)
+                for (uint32 right = left + 1; right < partition.GetSourceCount(); ++right)
+                    if (partition.GetIsland(left) != partition.GetIsland(right))
+                        REQUIRE(!Overlap(partition.GetArea(left), partition.GetArea(right), haloCells));
+        }
+    }
+}